@@ -0,0 +1,111 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: date_sort_bench.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <date_sort.h>
+#include <event_store.h>
+#include <timeline_event.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace linea_one;
+using Clock = std::chrono::steady_clock;
+
+// Sorting whole events needs about 100 bytes each, larger runs skip it
+#define DATE_SORT_BENCH_MAX_EVENT_SORT 2000000
+
+namespace {
+
+template <typename Run>
+double Milliseconds(const Run& run) {
+  const auto start = Clock::now();
+  run();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+}  // namespace
+
+/* date_sort_bench [events...], 1e5, 1e6 and 1e7 random dates by default */
+int main(int argc, char** argv) {
+  std::vector<std::size_t> counts;
+  for (int i = 1; i < argc; ++i) {
+    counts.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (counts.empty()) {
+    counts = {100000, 1000000, 10000000};
+  }
+  std::cout << std::format("{:>9} {:>14} {:>14} {:>14} {:>14}\n", "events",
+    "event sort ms", "key sort ms", "SortDates ms", "sort_by_date ms");
+  for (const auto count : counts) {
+    std::mt19937 random(7);
+    std::vector<EventDate> dates;
+    dates.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      dates.push_back(*EventDate::Make(static_cast<int>(random() % 6000) - 3000,
+        1 + random() % 12, 1 + random() % 28));
+    }
+
+    // Comparison sort of whole events, what sorting did before the store
+    std::string event_sort = "-";
+    if (count <= DATE_SORT_BENCH_MAX_EVENT_SORT) {
+      std::vector<TimelineEvent> events;
+      events.reserve(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        events.push_back({i + 1, dates[i], "headline of the event", false,
+          "description of the event"});
+      }
+      event_sort = std::format("{:.1f}", Milliseconds([&] {
+        std::ranges::stable_sort(events, {}, &TimelineEvent::date);
+      }));
+    }
+
+    std::vector<uint64_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    const double key_sort = Milliseconds([&] {
+      std::ranges::stable_sort(
+        order, {}, [&dates](uint64_t const i) { return dates[i]; });
+    });
+
+    std::vector<uint64_t> radix_order;
+    const double radix =
+      Milliseconds([&] { radix_order = *SortDates(dates); });
+    if (radix_order != order) {
+      std::cerr << "SortDates and stable_sort disagree" << std::endl;
+      return 1;
+    }
+
+    EventStore store;
+    store.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      store.emplace_back(i + 1, dates[i], "headline", false, "");
+    }
+    const double store_sort = Milliseconds([&] { (void)store.sort_by_date(); });
+
+    std::cout << std::format("{:>9} {:>14} {:>14.1f} {:>14.1f} {:>14.1f}\n",
+      count, event_sort, key_sort, radix, store_sort);
+  }
+}
@@ -0,0 +1,111 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_delete_bench.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <event_store.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace linea_one;
+using Clock = std::chrono::steady_clock;
+
+// Deleting one at a time costs the store size per event, bigger runs skip it
+#define EVENT_DELETE_BENCH_MAX_SHIFTED 2000000000ull
+
+namespace {
+
+template <typename Run>
+double Milliseconds(const Run& run) {
+  const auto start = Clock::now();
+  run();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+EventStore MakeStore(std::size_t const count) {
+  std::mt19937 random(11);
+  EventStore store;
+  store.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    store.emplace_back(i + 1,
+      *EventDate::Make(static_cast<int>(random() % 6000) - 3000,
+        1 + random() % 12, 1 + random() % 28),
+      "headline", false, "");
+  }
+  return store;
+}
+
+}  // namespace
+
+/* event_delete_bench [events], 500000 by default. Deletes growing numbers of
+ * random events by id, one erase each and all at once with erase_ids, and
+ * the same number from the end of the store. */
+int main(int argc, char** argv) {
+  const std::size_t count =
+    argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+  std::cout << std::format("{:>9} {:>9} {:>14} {:>14} {:>14}\n", "events",
+    "deletes", "erase ms", "erase_ids ms", "erase last ms");
+  for (std::size_t deletes = 10; deletes <= count; deletes *= 10) {
+    std::vector<uint64_t> ids(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      ids[i] = i + 1;
+    }
+    std::ranges::shuffle(ids, std::mt19937(static_cast<unsigned>(deletes)));
+    ids.resize(deletes);
+
+    std::string one_by_one = "-";
+    // Fresh stores, a copy would clone its columns on the first erase
+    EventStore erased = MakeStore(count);
+    if (deletes * count <= EVENT_DELETE_BENCH_MAX_SHIFTED) {
+      one_by_one = std::format("{:.1f}", Milliseconds([&] {
+        for (const auto id : ids) {
+          erased.erase(erased.find(id).Index());
+        }
+      }));
+    }
+
+    EventStore batched = MakeStore(count);
+    std::size_t removed = 0;
+    const double batch =
+      Milliseconds([&] { removed = batched.erase_ids(ids); });
+    if (removed != deletes ||
+        (one_by_one != "-" &&
+          !std::ranges::equal(batched.ids(), erased.ids()))) {
+      std::cerr << "erase and erase_ids disagree" << std::endl;
+      return 1;
+    }
+
+    // The last events shift nothing, each erase costs only itself
+    EventStore trimmed = MakeStore(count);
+    const double last = Milliseconds([&] {
+      for (std::size_t i = 0; i < deletes; ++i) {
+        trimmed.erase(trimmed.size() - 1 - (i % 2));
+      }
+    });
+
+    std::cout << std::format("{:>9} {:>9} {:>14} {:>14.2f} {:>14.2f}\n",
+      count, deletes, one_by_one, batch, last);
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: jsonlo_write_bench.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_jsonlo_reader.h>
+#include <io/io_jsonlo_writer.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace linea_one;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// The serializer JsonloWriter replaced, std::format and json::dump per
+// event into a growing string
+std::string FormatWrite(const Document& document) {
+  auto json_string = std::format(
+    "{{\n  \"Name\": {},\n  \"State\": {{\n    \"Zoom\": {},\n"
+    "    \"Offset\": {}\n  }},\n  \"Events\": [\n",
+    nlohmann::json(document.name).dump(), document.state.zoom,
+    document.state.offset);
+  for (std::size_t i = 0; i < document.events.size(); ++i) {
+    const auto event = document.events[i];
+    json_string += std::format(
+      "    {{\n      \"Id\": {},\n      \"Year\": {},\n"
+      "      \"Month\": {},\n      \"Day\": {},\n"
+      "      \"Headline\": {},\n      \"Description\": {},\n"
+      "      \"Expanded\": {}\n    }}",
+      event.id, event.date.Year(), event.date.Month(), event.date.Day(),
+      nlohmann::json(std::string(event.headline.str())).dump(),
+      nlohmann::json(std::string(event.description.str())).dump(),
+      bool(event.expanded));
+    json_string += i + 1 != document.events.size() ? ",\n" : "\n";
+  }
+  json_string += "  ]\n}\n";
+  return json_string;
+}
+
+template <typename Write>
+void Measure(const char* name, const Write& write) {
+  double best = 1e300;
+  std::size_t bytes = 0;
+  for (int run = 0; run < 5; ++run) {
+    const auto start = Clock::now();
+    bytes = write().size();
+    best = std::min(best,
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  }
+  std::cout << std::format("{:<12} {:8.1f} MB {:8.0f} ms {:8.0f} MB/s\n", name,
+    bytes / 1e6, best, bytes / 1e3 / best);
+}
+
+Document Generate(std::size_t const count) {
+  std::mt19937 random(5);
+  // Mostly plain words, now and then one that needs escaping or is not
+  // ASCII
+  const std::string words[] = {"treaty", "war", "crown", "city", "river",
+    "empire", "council", "harbour", "r\xC3\xA9gime", "\"the\"", "path\\to",
+    "line\nbreak"};
+  const auto text = [&](std::size_t length) {
+    std::string result;
+    while (result.size() < length) {
+      const auto word = random() % 64;
+      result += words[word < std::size(words) ? word : word % 8];
+      result += ' ';
+    }
+    return result;
+  };
+  Document document;
+  document.name = "Benchmark";
+  for (std::size_t i = 0; i < count; ++i) {
+    document.events.emplace_back(i + 1,
+      *EventDate::Make(static_cast<int>(random() % 4000) - 2000,
+        1 + random() % 12, 1 + random() % 28),
+      text(30), i % 2 == 0, text(100));
+  }
+  return document;
+}
+
+}  // namespace
+
+/* jsonlo_write_bench [events | file.jsonlo], 500000 generated
+ * events by default */
+int main(int argc, char** argv) {
+  Document document;
+  if (argc > 1 && std::filesystem::is_regular_file(argv[1])) {
+    std::ifstream file(argv[1], std::ios::binary);
+    auto read =
+      io::JsonloReader::Read(file, std::filesystem::file_size(argv[1]));
+    if (!read) {
+      std::cerr << "Unable to read " << argv[1] << std::endl;
+      return 1;
+    }
+    document = std::move(*read);
+  } else {
+    document = Generate(
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000);
+  }
+  std::cout << document.events.size() << " events\n";
+  Measure("format", [&] { return FormatWrite(document); });
+  Measure("JsonloWriter", [&] { return io::JsonloWriter::Write(document); });
+}
@@ -0,0 +1,116 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: timeline_cull_bench.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <event_store.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace linea_one;
+using Clock = std::chrono::steady_clock;
+
+// Events in view, the rest of the document is off screen
+#define TIMELINE_CULL_BENCH_VISIBLE 2000
+#define TIMELINE_CULL_BENCH_FRAMES 20
+
+namespace {
+
+// Stand-in for MapYearToPixel, the per event work of a frame
+float Pixel(double const years, double const first, double const width) {
+  return static_cast<float>((years - first) * width);
+}
+
+template <typename Frame>
+double Microseconds(const Frame& frame) {
+  const auto start = Clock::now();
+  for (int i = 0; i < TIMELINE_CULL_BENCH_FRAMES; ++i) {
+    frame();
+  }
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+           .count() /
+         TIMELINE_CULL_BENCH_FRAMES;
+}
+
+}  // namespace
+
+/* timeline_cull_bench [events...], a sorted document two years long
+ * viewed zoomed in on TIMELINE_CULL_BENCH_VISIBLE of its events */
+int main(int argc, char** argv) {
+  std::vector<std::size_t> counts;
+  for (int i = 1; i < argc; ++i) {
+    counts.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (counts.empty()) {
+    counts = {10000, 100000, 1000000, 10000000};
+  }
+  std::cout << std::format("{:>9} {:>9} {:>12} {:>12}\n", "events", "visible",
+    "scan us", "search us");
+  for (const auto count : counts) {
+    std::mt19937 random(23);
+    EventStore store;
+    store.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      store.emplace_back(i + 1,
+        *EventDate::Make(1999 + static_cast<int>(random() % 2),
+          1 + random() % 12, 1 + random() % 28, random() % 86400),
+        "", false, "");
+    }
+    (void)store.sort_by_date();
+    const auto dates = store.dates();
+    const std::size_t middle = count / 2;
+    const double first = dates[middle].Years();
+    const double last =
+      dates[std::min(count - 1, middle + TIMELINE_CULL_BENCH_VISIBLE - 1)]
+        .Years();
+    const double width = 1000 / (last - first);
+
+    std::size_t scanned = 0;
+    volatile float sink = 0;
+    // Every event mapped to a pixel and tested against the canvas
+    const double scan = Microseconds([&] {
+      scanned = 0;
+      for (const auto date : dates) {
+        const float x = Pixel(date.Years(), first, width);
+        if (x >= 0 && x <= 1000) {
+          sink = sink + x;
+          ++scanned;
+        }
+      }
+    });
+    std::size_t searched = 0;
+    const double search = Microseconds([&] {
+      const auto [begin, end] = store.sorted_between(first, last);
+      searched = end - begin;
+      for (std::size_t i = begin; i < end; ++i) {
+        sink = sink + Pixel(dates[i].Years(), first, width);
+      }
+    });
+    if (scanned != searched) {
+      std::cerr << "scan and search disagree" << std::endl;
+      return 1;
+    }
+    std::cout << std::format(
+      "{:>9} {:>9} {:>12.1f} {:>12.1f}\n", count, searched, scan, search);
+  }
+}
@@ -1,16 +1,43 @@
 set(headers
     headers/app.h
+    headers/cli.h
     headers/document.h
+    headers/event_text.h
+    headers/copy_on_write.h
+    headers/slot_map.h
+    headers/copy_counter.h
+    headers/event_store.h
+    headers/date_sort.h
+    headers/parallel_for.h
+    headers/text_arena.h
+    headers/utf8.h
+    headers/event_date.h
+    headers/year_index.h
+    headers/id_index.h
+    headers/document_changes.h
+    headers/document_history.h
     headers/document_manager.h
     headers/input_manager.h
     headers/renderer.h
     headers/svg_icon.h
     headers/timeline_state.h
+    headers/text_measure_cache.h
     headers/export_document.h
+    headers/io/io_binlo_codec.h
+    headers/io/io_document_format.h
+    headers/io/io_file_sync.h
+    headers/io/io_gzip_stream.h
+    headers/io/io_journal.h
+    headers/io/io_jsonlo_reader.h
+    headers/io/io_jsonlo_writer.h
+    headers/io/io_mapped_file.h
+    headers/io/io_recovery.h
+    headers/io/io_write_queue.h
     headers/ui/ui_elements.h
     headers/ui/ui_manager.h
     headers/ui/ui_main_menu.h
     headers/ui/ui_document_tab.h
+    headers/ui/ui_document_view.h
     headers/ui/ui_modal_dialogs.h
     headers/ui/ui_draw_timeline.h
 )
@@ -1,14 +1,39 @@
+# Everything the headless cli needs, no SDL or ImGui in here
+set(core_sources
+    src/document_changes.cpp
+    src/document_history.cpp
+    src/document_manager.cpp
+    src/event_store.cpp
+    src/date_sort.cpp
+    src/parallel_for.cpp
+    src/text_measure_cache.cpp
+    src/export_document.cpp
+    src/text_arena.cpp
+    src/event_date.cpp
+    src/year_index.cpp
+    src/id_index.cpp
+    src/io/io_binlo_codec.cpp
+    src/io/io_file_sync.cpp
+    src/io/io_gzip_stream.cpp
+    src/io/io_journal.cpp
+    src/io/io_jsonlo_reader.cpp
+    src/io/io_jsonlo_writer.cpp
+    src/io/io_mapped_file.cpp
+    src/io/io_recovery.cpp
+    src/io/io_write_queue.cpp
+)
+
 set(sources
+    ${core_sources}
     src/app.cpp
-    src/document_manager.cpp
     src/input_manager.cpp
     src/renderer.cpp
     src/svg_icon.cpp
-    src/export_document.cpp
     src/ui/ui_elements.cpp
     src/ui/ui_manager.cpp
     src/ui/ui_main_menu.cpp
     src/ui/ui_document_tab.cpp
+    src/ui/ui_document_view.cpp
     src/ui/ui_modal_dialogs.cpp
     src/ui/ui_draw_timeline.cpp
 )
@@ -16,4 +41,10 @@ set(sources
 set(exe_sources
     ${sources}
     src/main.cpp
-)
\ No newline at end of file
+)
+
+# Linked against lineaone-core
+set(cli_sources
+    src/cli.cpp
+    src/cli_main.cpp
+)
@@ -0,0 +1,73 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: cli.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document_manager.h>
+#include <export_document.h>
+#include <io/io_document_format.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace linea_one {
+
+#define CLI_EXIT_OK 0
+#define CLI_EXIT_FAILED 1
+#define CLI_EXIT_USAGE 2
+// Input and output name that stands for stdin and stdout
+#define CLI_STDIO_PATH "-"
+
+enum class CliCommand { kValidate = 0, kConvert, kExport };
+
+struct CliOptions {
+  CliCommand command = CliCommand::kValidate;
+  io::DocumentFormat input_format = io::DocumentFormat::kJsonlo;
+  io::DocumentFormat output_format = io::DocumentFormat::kJsonlo;
+  std::filesystem::path output_dir;
+  uint32_t jobs = 0;
+  std::vector<std::filesystem::path> inputs;
+};
+
+/* Headless front end, the same DocumentManager and ExportDocument as the app
+ * without SDL or ImGui. Files are processed in parallel, one per worker. */
+class Cli {
+ public:
+  int Run(int argc, char** argv);
+
+ private:
+  bool ParseArguments(const std::vector<std::string>& arguments);
+  static std::optional<io::DocumentFormat> ParseFormat(const std::string& name);
+  static void PrintUsage();
+  bool ProcessFile(const std::filesystem::path& path);
+  bool ProcessStdio();
+  bool Validate(const Document& document, const std::string& name) const;
+  [[nodiscard]] std::filesystem::path OutputPath(
+    const std::filesystem::path& input, const char* extension) const;
+
+  CliOptions options_;
+  DocumentManager doc_man_;
+  ExportDocument export_doc_;
+};
+
+}  // namespace linea_one
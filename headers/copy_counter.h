@@ -0,0 +1,56 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: copy_counter.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace linea_one {
+
+/* A member that counts how often its owner T is copied, so a path that
+ * should only move can be checked. Debug builds only, with NDEBUG it is an
+ * empty member and Copies stays zero. */
+template <typename T>
+struct CopyCounter {
+#ifndef NDEBUG
+  CopyCounter() = default;
+  CopyCounter(const CopyCounter&) {
+    copies.fetch_add(1, std::memory_order_relaxed);
+  }
+  CopyCounter(CopyCounter&&) noexcept = default;
+  CopyCounter& operator=(const CopyCounter&) {
+    copies.fetch_add(1, std::memory_order_relaxed);
+    return *this;
+  }
+  CopyCounter& operator=(CopyCounter&&) noexcept = default;
+
+  [[nodiscard]] static uint64_t Copies() {
+    return copies.load(std::memory_order_relaxed);
+  }
+
+ private:
+  inline static std::atomic<uint64_t> copies{0};
+#else
+  [[nodiscard]] static uint64_t Copies() { return 0; }
+#endif
+};
+
+}  // namespace linea_one
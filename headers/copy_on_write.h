@@ -0,0 +1,86 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: copy_on_write.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace linea_one {
+
+/* A value shared by all copies until one of them writes to it, which then
+ * clones it first. Copying is a reference count increment, so a copy can be
+ * handed to another thread while the original keeps being edited. Only the
+ * thread that owns a copy may call Write on it. */
+template <typename T>
+class CopyOnWrite {
+ public:
+  CopyOnWrite() : p_shared_(new Shared(T())) {}
+  // No move members, a moved from store must stay usable, e.g. cleared
+  CopyOnWrite(const CopyOnWrite& other) : p_shared_(other.p_shared_) {
+    p_shared_->owners.fetch_add(1, std::memory_order_relaxed);
+  }
+  CopyOnWrite& operator=(const CopyOnWrite& other) {
+    CopyOnWrite copy(other);
+    std::swap(p_shared_, copy.p_shared_);
+    return *this;
+  }
+  ~CopyOnWrite() { Release(); }
+
+  const T& operator*() const { return p_shared_->value; }
+  const T* operator->() const { return &p_shared_->value; }
+
+  T& Write() {
+    if (IsShared()) {
+      auto* p_clone = new Shared(p_shared_->value);
+      Release();
+      p_shared_ = p_clone;
+    }
+    return p_shared_->value;
+  }
+  /* Replaces the value without cloning the shared one. */
+  void Reset(T value) {
+    auto* p_fresh = new Shared(std::move(value));
+    Release();
+    p_shared_ = p_fresh;
+  }
+  /* Acquires, so once false the other copies' reads are done with. */
+  [[nodiscard]] bool IsShared() const {
+    return p_shared_->owners.load(std::memory_order_acquire) > 1;
+  }
+
+ private:
+  struct Shared {
+    explicit Shared(T initial) : value(std::move(initial)) {}
+    std::atomic<std::size_t> owners{1};
+    T value;
+  };
+
+  void Release() {
+    if (p_shared_->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete p_shared_;
+    }
+  }
+
+  Shared* p_shared_;
+};
+
+}  // namespace linea_one
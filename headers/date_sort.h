@@ -0,0 +1,47 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: date_sort.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <event_date.h>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+namespace linea_one {
+
+// 2048 buckets, the counts of one part stay in L1
+#define DATE_SORT_DIGIT_BITS 11
+
+/* Positions of dates in date order, equal dates keep their order. A radix
+ * sort of compact keys, each pass split over the hardware threads, digits
+ * every date shares are skipped. Keys hold the date relative to the
+ * smallest one and, when it fits, the position in the same 64 bits.
+ * Nullopt once stop is requested, progress is called with the share done
+ * after each pass. */
+std::optional<std::vector<uint64_t>> SortDates(std::span<const EventDate> dates,
+  const std::stop_token& stop = {},
+  const std::function<void(float)>& progress = {});
+
+}  // namespace linea_one
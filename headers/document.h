@@ -20,7 +20,10 @@
  */
 #pragma once
 
-#include <timeline_event.h>
+#include <copy_counter.h>
+#include <document_changes.h>
+#include <document_history.h>
+#include <event_store.h>
 #include <timeline_state.h>
 
 #include <filesystem>
@@ -32,8 +35,17 @@ struct Document {
   std::string name;
   bool saved;
   TimelineState state;
-  std::vector<TimelineEvent> events;
+  EventStore events;
   std::filesystem::path path;
+  DocumentChanges changes;
+  DocumentHistory history;
+  // Revision of changes that is on disk at synced_path
+  uint64_t saved_revision = 0;
+  std::filesystem::path synced_path;
+  // Crash recovery file, empty while there is nothing to recover
+  std::filesystem::path recovery_path;
+  uint64_t recovery_revision = 0;
+  [[no_unique_address]] CopyCounter<Document> copy_counter;
 };
 
 }  // namespace linea_one
\ No newline at end of file
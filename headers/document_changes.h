@@ -0,0 +1,55 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: document_changes.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace linea_one {
+
+struct DocumentDelta {
+  std::vector<uint64_t> changed;
+  std::vector<uint64_t> deleted;
+  bool order_changed = false;
+};
+
+/* Records which events were edited, deleted or reordered. Every mark bumps a
+ * revision, so each consumer (saving, ...) asks only for what changed after
+ * the revision it has already written. */
+class DocumentChanges {
+ public:
+  void MarkEvent(uint64_t id);
+  void MarkDeleted(uint64_t id);
+  void MarkOrder();
+  [[nodiscard]] uint64_t Revision() const;
+  [[nodiscard]] DocumentDelta Since(uint64_t revision) const;
+  /* Drops the history up to revision once no consumer needs it. */
+  void Forget(uint64_t revision);
+
+ private:
+  uint64_t revision_ = 0;
+  uint64_t order_revision_ = 0;
+  std::unordered_map<uint64_t, uint64_t> changed_;
+  std::unordered_map<uint64_t, uint64_t> deleted_;
+};
+
+}  // namespace linea_one
@@ -0,0 +1,119 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: document_history.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document_changes.h>
+#include <event_store.h>
+#include <timeline_event.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace linea_one {
+
+#define DOCUMENT_HISTORY_BUDGET_BYTES (16 * 1024 * 1024)
+
+// Each edit keeps only what it changed, field edits find their event by id
+struct InsertEdit {
+  uint64_t position;
+  TimelineEvent event;
+};
+struct DeleteEdit {
+  uint64_t position;
+  TimelineEvent event;
+};
+struct DateEdit {
+  uint64_t id;
+  EventDate before;
+  EventDate after;
+  // Positions when the new date moved the event, equal when it stayed
+  uint64_t from = 0;
+  uint64_t to = 0;
+};
+struct ExpandedEdit {
+  uint64_t id;
+};
+/* The bytes between a common prefix and suffix of the old and new text. */
+struct TextEdit {
+  uint64_t id;
+  TextField field;
+  uint64_t offset;
+  std::string removed;
+  std::string inserted;
+};
+struct SwapEdit {
+  uint64_t a;
+  uint64_t b;
+};
+struct OrderEdit {
+  std::vector<uint64_t> order;
+};
+
+using Edit = std::variant<InsertEdit, DeleteEdit, DateEdit, ExpandedEdit,
+  TextEdit, SwapEdit, OrderEdit>;
+
+/* Undo and redo of a document as a log of edits. Typing into one field or
+ * dragging one date field is a single step until Seal, and the oldest steps are
+ * dropped once the log outgrows its byte budget. Undoing a field edit or a
+ * swap costs the same whatever the document size, inserts and deletes move
+ * the columns like the edit itself did. */
+class DocumentHistory {
+ public:
+  void RecordInsert(uint64_t position, TimelineEvent event);
+  void RecordDelete(uint64_t position, TimelineEvent event);
+  void RecordDate(uint64_t id, EventDate before, EventDate after);
+  /* The event whose date was just recorded moved to keep the events in
+   * date order, it joins that step. */
+  void RecordMove(uint64_t id, EventDate date, uint64_t from, uint64_t to);
+  void RecordExpanded(uint64_t id);
+  void RecordText(
+    uint64_t id, TextField field, std::string_view before, std::string_view after);
+  void RecordSwap(uint64_t a, uint64_t b);
+  void RecordOrder(std::vector<uint64_t> order);
+  /* The next edit starts a new step instead of extending the last one. */
+  void Seal();
+
+  bool Undo(EventStore& events, DocumentChanges& changes);
+  bool Redo(EventStore& events, DocumentChanges& changes);
+  [[nodiscard]] bool CanUndo() const;
+  [[nodiscard]] bool CanRedo() const;
+
+  void SetBudget(std::size_t bytes);
+  [[nodiscard]] std::size_t Bytes() const;
+  void Clear();
+
+ private:
+  void Push(Edit edit);
+  void Trim();
+
+  std::deque<Edit> undo_;
+  std::deque<Edit> redo_;
+  bool sealed_ = true;
+  std::size_t bytes_ = 0;
+  std::size_t budget_ = DOCUMENT_HISTORY_BUDGET_BYTES;
+};
+
+}  // namespace linea_one
@@ -21,39 +21,160 @@
 #pragma once
 
 #include <document.h>
+#include <io/io_document_format.h>
+#include <io/io_journal.h>
+#include <io/io_recovery.h>
+#include <io/io_write_queue.h>
+#include <slot_map.h>
 
-
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <thread>
 #include <vector>
-#include <nlohmann/json.hpp>
 
 namespace linea_one {
 
+enum class SaveResult { kFailed = 0, kJournaled, kWritten };
+enum class CloseResult { kMissing = 0, kClosed, kUnsaved };
+
+// Stays valid while the document is open, a closed document's handle
+// resolves to nothing
+using DocumentHandle = SlotHandle;
+
+struct PendingSave {
+  DocumentHandle document;
+  uint64_t revision;
+  std::filesystem::path path;
+  std::future<SaveResult> result;
+};
+
+struct SortResult {
+  EventStore events;
+  std::vector<uint64_t> order;
+};
+
+struct PendingSort {
+  DocumentHandle document;
+  // Revision the snapshot was taken at, later edits void the result
+  uint64_t revision;
+  // Set by the worker, read by the frame
+  std::shared_ptr<std::atomic<float>> p_progress;
+  std::future<SortResult> result;
+  std::jthread worker;
+};
+
+struct PendingLoad {
+  std::filesystem::path path;
+  std::future<std::optional<Document>> result;
+};
+
 class DocumentManager {
  public:
   DocumentManager();
-  void CreateNewDocument();
+  DocumentManager(const DocumentManager&) = delete;
+  DocumentManager& operator=(const DocumentManager&) = delete;
+  ~DocumentManager();
+  DocumentHandle CreateNewDocument();
   /*Never call this function before "CloseDocumentWithCheck" */
   void CloseDocument();
-  int32_t CloseDocumentWithCheck(int32_t const index);
+  CloseResult CloseDocumentWithCheck(DocumentHandle const handle);
   Document* GetCurrentDocument();
-  [[nodiscard]] int32_t DocumentSize() const;
-  [[nodiscard]] Document& GetSpecificDocument(int32_t const index);
-  [[nodiscard]] int32_t GetCurrentDocumentIndex() const;
-  [[nodiscard]] int32_t GetDocToClose() const;
-  void SetCurrentDocumentIndex(int32_t const index);
-  void SetDocToClose(int32_t const index);
-  void SetDocOnIndex(Document& document, int64_t const index);
+  /* Null once the document is closed */
+  [[nodiscard]] Document* GetDocument(DocumentHandle const handle);
+  /* Open documents in tab order */
+  [[nodiscard]] const std::vector<DocumentHandle>& GetDocuments() const;
+  [[nodiscard]] DocumentHandle GetCurrentDocumentHandle() const;
+  [[nodiscard]] DocumentHandle GetDocToClose() const;
+  void SetCurrentDocument(DocumentHandle const handle);
+  void SetDocToClose(DocumentHandle const handle);
+  /* Steps the current document's history, false when there is nothing to
+   * step or the step no longer applies */
+  bool Undo();
+  bool Redo();
+  [[nodiscard]] bool CanUndo();
+  [[nodiscard]] bool CanRedo();
   void SaveDocument();
-  void LoadDocument(std::filesystem::path path);
+  void SaveDocument(DocumentHandle const handle);
+  /* Applies finished background saves and loads, call once per frame */
+  void Update();
+  [[nodiscard]] bool IsSaving(DocumentHandle const handle) const;
+  /* Sorts a snapshot of the events by date on a worker thread, Update puts
+   * the result in place of the events */
+  void SortDocument(DocumentHandle const handle);
+  [[nodiscard]] bool IsSorting(DocumentHandle const handle) const;
+  /* 0 to 1, nullopt when the document is not sorting */
+  [[nodiscard]] std::optional<float> GetSortProgress(
+    DocumentHandle const handle) const;
+  /* The events keep their order, IsSorting stays true until the worker
+   * notices */
+  void CancelSort(DocumentHandle const handle);
+  /* Empty handle when the file can not be read */
+  DocumentHandle LoadDocument(std::filesystem::path path);
+  /* Parses the files on worker threads, each document is added by Update
+   * as soon as it is ready */
+  void LoadDocuments(const std::vector<std::filesystem::path>& paths);
+  [[nodiscard]] bool IsLoading() const;
+  void SetJournalMode(bool const journal_mode);
+  [[nodiscard]] bool GetJournalMode() const;
+  /* Zero turns autosave off */
+  void SetAutosaveInterval(std::chrono::seconds const interval);
+  [[nodiscard]] std::chrono::seconds GetAutosaveInterval() const;
+  [[nodiscard]] std::vector<io::RecoveredDocument> FindRecoveries() const;
+  void RestoreDocuments(const std::vector<io::RecoveredDocument>& recoveries);
+  void DiscardRecoveries(const std::vector<io::RecoveredDocument>& recoveries);
+  /* Reads a file with its journaled saves applied, without opening a tab.
+   * Safe to call from any thread, like WriteDocument. */
+  std::optional<Document> OpenDocument(const std::filesystem::path& path);
+  /* Plain .jsonlo text, e.g. stdin */
+  std::optional<Document> ReadDocument(std::istream& stream);
+  bool WriteDocument(const Document& document, const std::filesystem::path& path,
+    io::DocumentFormat const format);
+  bool WriteDocument(const Document& document, std::ostream& stream);
 
  private:
-  std::string SerializeDocument(Document &document);
-  Document DeserializeDocument(std::ifstream &json_file);
-  std::vector<Document> documents_;
+  std::optional<Document> ReadDocument(const std::filesystem::path& path);
+  DocumentHandle AddDocument(
+    const std::filesystem::path& path, std::optional<Document> document);
+  SaveResult WriteSnapshot(const Document& snapshot, const DocumentDelta& delta,
+    bool const append, bool const journal_mode);
+  void FinishSave(PendingSave& pending, SaveResult const result);
+  /* False when the document changed during the sort and needs another */
+  bool FinishSort(PendingSort& pending, SortResult result);
+  void StartCompaction(const std::filesystem::path& path);
+  void CompactJournal(const std::filesystem::path& path);
+  void Autosave();
+  void StartRecovery(Document& document);
+  void DropRecovery(Document& document);
+  std::string SerializeDocument(const Document &document);
+  std::optional<Document> DeserializeDocument(
+    std::ifstream &json_file, std::uintmax_t const size_hint);
+  // Documents never move, background jobs hold handles and check them on
+  // return
+  SlotMap<Document> documents_;
+  std::vector<DocumentHandle> tab_order_;
   uint64_t new_doc_counter = 0;
-  int32_t current_document_ = -1;
-  int32_t doc_to_close_ = -1;
+  DocumentHandle current_document_;
+  DocumentHandle doc_to_close_;
+  std::shared_ptr<io::Journal> p_journal_;
+  bool journal_mode_ = true;
+  std::atomic<bool> is_compacting_{false};
+  std::jthread compaction_thread_;
+  std::vector<PendingSave> pending_saves_;
+  std::vector<PendingLoad> pending_loads_;
+  std::vector<PendingSort> pending_sorts_;
+  std::chrono::seconds autosave_interval_{AUTOSAVE_DEFAULT_INTERVAL_SECONDS};
+  std::chrono::steady_clock::time_point last_autosave_ =
+    std::chrono::steady_clock::now();
+  // Workers are joined first, so anything they use outlives them
+  io::WriteQueue recovery_queue_;
+  io::WriteQueue write_queue_;
+  std::vector<std::jthread> load_threads_;
 };
 
 }  // namespace linea_one
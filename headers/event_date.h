@@ -0,0 +1,110 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_date.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace linea_one {
+
+#define DATE_YEAR_SHIFT 26
+#define DATE_MONTH_SHIFT 22
+#define DATE_DAY_SHIFT 17
+#define DATE_SECONDS_PER_DAY 86400
+
+/* A point on the timeline packed into one signed 64-bit key:
+ *   year (38 bits, signed) | month (4) | day (5) | second of day + 1 (17)
+ * Zero in a field means the date stops at the coarser one, so 1999 sorts
+ * before 1999-01 and that before 1999-01-01. Comparing two dates is one
+ * integer compare. The era is the sign of the year: -44 is 44 BC. */
+class EventDate {
+ public:
+  constexpr EventDate() = default;
+  // Implicit, a year alone is still a valid date
+  constexpr EventDate(int const year)
+    : key_(static_cast<int64_t>(year) * (int64_t{1} << DATE_YEAR_SHIFT)) {}
+
+  /* Month 0 leaves out day and time, day 0 leaves out time, a negative
+   * second has no time. Nullopt when a field is out of range. */
+  static std::optional<EventDate> Make(
+    int year, int month, int day = 0, int second = -1);
+  static constexpr EventDate FromKey(int64_t const key) {
+    EventDate date;
+    date.key_ = key;
+    return date;
+  }
+
+  [[nodiscard]] constexpr int64_t Key() const { return key_; }
+  [[nodiscard]] constexpr int Year() const {
+    return static_cast<int>(key_ >> DATE_YEAR_SHIFT);
+  }
+  /* 1 to 12, 0 when the date is a whole year. */
+  [[nodiscard]] constexpr int Month() const {
+    return static_cast<int>(key_ >> DATE_MONTH_SHIFT) & 0x0F;
+  }
+  /* 1 to 31, 0 when the date is a whole month or year. */
+  [[nodiscard]] constexpr int Day() const {
+    return static_cast<int>(key_ >> DATE_DAY_SHIFT) & 0x1F;
+  }
+  [[nodiscard]] constexpr bool HasTime() const {
+    return (key_ & 0x1FFFF) != 0;
+  }
+  /* Seconds since midnight, 0 without a time. */
+  [[nodiscard]] constexpr int Second() const {
+    return HasTime() ? static_cast<int>(key_ & 0x1FFFF) - 1 : 0;
+  }
+  /* The same date in another year or month, a day past the end of the
+   * month becomes its last day (29 February in a common year). Month 0
+   * makes it a whole year. */
+  [[nodiscard]] EventDate WithYear(int year) const;
+  [[nodiscard]] EventDate WithMonth(int month) const;
+  /* Day 0 makes it a whole month, a whole year stays one. */
+  [[nodiscard]] EventDate WithDay(int day) const;
+  /* Fields a file may hold but Make would refuse, e.g. month 13. */
+  [[nodiscard]] bool IsValid() const;
+  /* The year plus the elapsed part of it, for placing the date on an axis.
+   * A whole year is its start, like a whole month or day. */
+  [[nodiscard]] double Years() const;
+
+  constexpr auto operator<=>(const EventDate&) const = default;
+
+ private:
+  static EventDate Clamped(int year, int month, int day, int second);
+
+  int64_t key_ = 0;
+};
+
+static_assert(sizeof(EventDate) == sizeof(int64_t) &&
+              std::is_trivially_copyable_v<EventDate>);
+
+[[nodiscard]] int DaysInMonth(int year, int month);
+/* "1999", "1999-03", "1999-03-14" or "1999-03-14 12:30:05", a BC year keeps
+ * its minus sign. */
+[[nodiscard]] std::string FormatDate(EventDate date);
+/* "HH:MM:SS" */
+[[nodiscard]] std::string FormatTimeOfDay(int second);
+/* "HH:MM" or "HH:MM:SS" to seconds since midnight. */
+[[nodiscard]] std::optional<int> ParseTimeOfDay(std::string_view text);
+
+}  // namespace linea_one
@@ -0,0 +1,353 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_store.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <copy_on_write.h>
+#include <event_text.h>
+#include <id_index.h>
+#include <text_arena.h>
+#include <timeline_event.h>
+#include <year_index.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace linea_one {
+
+#define EVENT_FLAG_EXPANDED 0x01
+// A move, insert or erase shifting more than 1/n of the events sweeps the
+// indexes instead of relocating each shifted event
+#define EVENT_STORE_SHIFT_SWEEP_SHARE 64
+// Part of a sort's progress spent on the keys, moving the columns is the rest
+#define EVENT_STORE_SORT_KEY_SHARE 0.25f
+
+/* One bit of an event's flags, reads and assigns like a bool. */
+class FlagRef {
+ public:
+  FlagRef(EventStore& store, uint32_t const position, uint8_t const mask)
+    : p_store_(&store), position_(position), mask_(mask) {}
+  FlagRef(const FlagRef&) = default;
+
+  operator bool() const;
+  FlagRef& operator=(bool value);
+  FlagRef& operator=(const FlagRef& other) {
+    return *this = static_cast<bool>(other);
+  }
+
+ private:
+  EventStore* p_store_;
+  uint32_t position_;
+  uint8_t mask_;
+};
+
+/* An event's date, assigning it also moves the event in the YearIndex. */
+class DateRef {
+ public:
+  DateRef(EventStore& store, uint32_t const position)
+    : p_store_(&store), position_(position) {}
+  DateRef(const DateRef&) = default;
+
+  operator EventDate() const;
+  DateRef& operator=(EventDate value);
+  DateRef& operator=(const DateRef& other) {
+    return *this = static_cast<EventDate>(other);
+  }
+
+ private:
+  EventStore* p_store_;
+  uint32_t position_;
+};
+
+/* An event seen through an EventStore. event.date = 5 writes straight into
+ * the store, nothing is copied until then. The id is read only, the store
+ * indexes events by it. */
+struct EventRef {
+  const uint64_t id;
+  DateRef date;
+  TextRef headline;
+  FlagRef expanded;
+  TextRef description;
+
+  operator TimelineEvent() const {
+    return {id, date, std::string(headline.str()), expanded,
+      std::string(description.str())};
+  }
+};
+
+struct ConstEventRef {
+  uint64_t id;
+  EventDate date;
+  ConstTextRef headline;
+  bool expanded;
+  ConstTextRef description;
+
+  operator TimelineEvent() const {
+    return {id, date, std::string(headline.str()), expanded,
+      std::string(description.str())};
+  }
+};
+
+template <typename Store, typename Ref>
+class EventIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = TimelineEvent;
+  using difference_type = std::ptrdiff_t;
+  using reference = Ref;
+  using pointer = void;
+
+  EventIterator() = default;
+  EventIterator(Store* p_store, std::size_t const index)
+    : p_store_(p_store), index_(index) {}
+
+  Ref operator*() const { return (*p_store_)[index_]; }
+  Ref operator[](difference_type const n) const { return (*p_store_)[index_ + n]; }
+  EventIterator& operator++() { ++index_; return *this; }
+  EventIterator operator++(int) { auto copy = *this; ++index_; return copy; }
+  EventIterator& operator--() { --index_; return *this; }
+  EventIterator operator--(int) { auto copy = *this; --index_; return copy; }
+  EventIterator& operator+=(difference_type const n) { index_ += n; return *this; }
+  EventIterator& operator-=(difference_type const n) { index_ -= n; return *this; }
+  EventIterator operator+(difference_type const n) const { return {p_store_, index_ + n}; }
+  EventIterator operator-(difference_type const n) const { return {p_store_, index_ - n}; }
+  difference_type operator-(const EventIterator& other) const {
+    return static_cast<difference_type>(index_) -
+           static_cast<difference_type>(other.index_);
+  }
+  bool operator==(const EventIterator& other) const { return index_ == other.index_; }
+  auto operator<=>(const EventIterator& other) const { return index_ <=> other.index_; }
+  [[nodiscard]] std::size_t Index() const { return index_; }
+
+ private:
+  Store* p_store_ = nullptr;
+  std::size_t index_ = 0;
+};
+
+/* Events of a document stored column by column. Passes that only need dates
+ * (min/max, culling, sorting) walk one contiguous array of date keys instead
+ * of whole events. Element access goes through EventRef proxies, so code
+ * keeps writing event.date and event.headline. Texts are handles into one
+ * TextArena, so loading a document allocates a few big blocks rather than
+ * two strings per event. A YearIndex over the date column is kept in step
+ * with every change, for range queries and per-year grouping.
+ *
+ * Copies share the columns until one side writes, then only the columns it
+ * writes are cloned. A copy is the snapshot a background job reads while
+ * the document stays editable. Holds up to 2^32 events. */
+class EventStore {
+ public:
+  using iterator = EventIterator<EventStore, EventRef>;
+  using const_iterator = EventIterator<const EventStore, ConstEventRef>;
+
+  [[nodiscard]] std::size_t size() const { return ids_->ids.size(); }
+  [[nodiscard]] bool empty() const { return ids_->ids.empty(); }
+  void reserve(std::size_t capacity);
+  void clear();
+  void resize(std::size_t count);
+
+  void push_back(TimelineEvent event);
+  template <typename... Args>
+  EventRef emplace_back(Args&&... args) {
+    push_back(TimelineEvent{std::forward<Args>(args)...});
+    return back();
+  }
+  /* Puts event before the one at index. Like erase it costs the events after
+   * index, up to a pass over the indexes. */
+  void insert(std::size_t index, TimelineEvent event);
+  void erase(std::size_t index);
+  /* Removes the events with these ids in one pass over the columns, so
+   * deleting many costs O(n) once instead of per event. Unknown ids are
+   * skipped, returns how many events were removed. */
+  std::size_t erase_ids(std::span<const uint64_t> ids);
+  /* Position of the event with id, end() when there is none. O(1). */
+  [[nodiscard]] iterator find(uint64_t id);
+  [[nodiscard]] const_iterator find(uint64_t id) const;
+  [[nodiscard]] bool contains(uint64_t id) const;
+  /* Changes the id of the event at index, e.g. while it is being read. */
+  void set_id(std::size_t index, uint64_t id);
+  /* A fresh id, larger than any id this store has held. */
+  uint64_t allocate_id();
+  /* Keeps the events whose removed entry is false, in their order. */
+  void compact(const std::vector<bool>& removed);
+  void swap(std::size_t a, std::size_t b);
+  /* The event at from ends up at to, the ones between shift by one. Costs
+   * the distance, not the size of the store. */
+  void move(std::size_t from, std::size_t to);
+  /* Where the event at index belongs when every other event is in date
+   * order, O(log n). Equal dates keep it as close to index as they can. */
+  [[nodiscard]] std::size_t ordered_position(std::size_t index) const;
+  /* Event order[i] moves to position i, order holds every index at most
+   * once and the events it leaves out are dropped. Large stores move their
+   * columns on several threads. */
+  void reorder(const std::vector<uint64_t>& order);
+  /* Stable, sorts the date keys only (see SortDates) and moves each column
+   * once. Returns the order it applied (see reorder), empty if already
+   * sorted, nullopt and unchanged once stop is requested. Progress goes
+   * from 0 to 1. */
+  std::optional<std::vector<uint64_t>> sort_by_date(
+    const std::stop_token& stop = {},
+    const std::function<void(float)>& progress = {});
+  /* True when the date column is in order, O(1). Then a date interval is
+   * one run of positions, found by binary search over dates(). */
+  [[nodiscard]] bool sorted_by_date() const;
+  /* Smallest and largest year, {INT_MAX, INT_MIN} when empty. */
+  [[nodiscard]] std::pair<int, int> year_range() const;
+  /* Positions of the events of every year, in year order. */
+  [[nodiscard]] const YearIndex::Groups& year_groups() const;
+  /* Like year_groups, limited to the years in [first, last]. */
+  [[nodiscard]] YearIndex::Range years_between(int first, int last) const;
+  /* Positions [begin, end) of the events whose Years() lie in [first,
+   * last], both ends included. Only for a sorted store, two binary
+   * searches over dates(). */
+  [[nodiscard]] std::pair<std::size_t, std::size_t> sorted_between(
+    double first, double last) const;
+  /* Lazy texts point into a source, see TextRef::SetLazy. */
+  uint32_t add_text_source(std::shared_ptr<const TextSource> p_source);
+  void reserve_text(std::size_t bytes);
+  /* Drops replaced texts once they make up half of the arena. */
+  bool compact_text();
+  [[nodiscard]] std::size_t text_size() const;
+
+  void set_date(std::size_t index, EventDate date);
+  void set_flag(std::size_t index, uint8_t mask, bool value);
+  /* A lazy text is loaded by the first read, unless the columns are shared
+   * with a copy. Then it is read into a buffer of this store, which the
+   * next such read reuses. Either way the view lasts only until the next
+   * lazy read, see ConstTextRef::str. */
+  [[nodiscard]] std::string_view text(TextField field, std::size_t index) const;
+  [[nodiscard]] TextHandle text_handle(
+    TextField field, std::size_t index) const;
+  void set_text(TextField field, std::size_t index, std::string_view text);
+  void set_lazy_text(TextField field, std::size_t index, uint32_t source,
+    uint64_t offset, uint32_t length);
+
+  EventRef operator[](std::size_t const index) {
+    const auto position = static_cast<uint32_t>(index);
+    return {ids_->ids[index], DateRef(*this, position),
+      TextRef(*this, TextField::kHeadline, position),
+      FlagRef(*this, position, EVENT_FLAG_EXPANDED),
+      TextRef(*this, TextField::kDescription, position)};
+  }
+  ConstEventRef operator[](std::size_t const index) const {
+    const auto position = static_cast<uint32_t>(index);
+    return {ids_->ids[index], dates_->dates[index],
+      ConstTextRef(*this, TextField::kHeadline, position),
+      ((*flags_)[index] & EVENT_FLAG_EXPANDED) != 0,
+      ConstTextRef(*this, TextField::kDescription, position)};
+  }
+  EventRef back() { return (*this)[size() - 1]; }
+  [[nodiscard]] ConstEventRef back() const { return (*this)[size() - 1]; }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, size()}; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator end() const { return {this, size()}; }
+
+  [[nodiscard]] std::span<const uint64_t> ids() const { return ids_->ids; }
+  [[nodiscard]] std::span<const EventDate> dates() const {
+    return dates_->dates;
+  }
+  [[nodiscard]] std::span<const uint8_t> flags() const { return *flags_; }
+
+ private:
+  struct IdColumn {
+    std::vector<uint64_t> ids;
+    IdIndex index;
+  };
+  struct DateColumn {
+    std::vector<EventDate> dates;
+    YearIndex index;
+    // Neighbours out of date order, kept so sortedness is known in O(1)
+    std::size_t descents = 0;
+  };
+  struct TextColumns {
+    std::vector<TextHandle> headlines;
+    std::vector<TextHandle> descriptions;
+  };
+
+  static std::vector<TextHandle>& Column(TextColumns& texts, TextField field);
+  void ReleaseText(const TextHandle& handle);
+
+  CopyOnWrite<IdColumn> ids_;
+  CopyOnWrite<DateColumn> dates_;
+  CopyOnWrite<std::vector<uint8_t>> flags_;
+  // Reading a lazy text loads it, so even const access updates these
+  mutable CopyOnWrite<TextColumns> handles_;
+  mutable CopyOnWrite<TextArena> texts_;
+  mutable std::string fetched_;
+};
+
+inline FlagRef::operator bool() const {
+  return (p_store_->flags()[position_] & mask_) != 0;
+}
+
+inline FlagRef& FlagRef::operator=(bool const value) {
+  p_store_->set_flag(position_, mask_, value);
+  return *this;
+}
+
+inline DateRef::operator EventDate() const {
+  return p_store_->dates()[position_];
+}
+
+inline DateRef& DateRef::operator=(EventDate const value) {
+  p_store_->set_date(position_, value);
+  return *this;
+}
+
+inline std::string_view ConstTextRef::str() const {
+  return p_store_->text(field_, position_);
+}
+
+inline const char* ConstTextRef::c_str() const {
+  const auto text = str();
+  return text.empty() ? "" : text.data();
+}
+
+inline std::size_t ConstTextRef::size() const {
+  return p_store_->text_handle(field_, position_).length;
+}
+
+inline bool ConstTextRef::IsLoaded() const {
+  return p_store_->text_handle(field_, position_).source == 0;
+}
+
+inline TextRef& TextRef::operator=(std::string_view const text) {
+  p_writable_store_->set_text(field_, position_, text);
+  return *this;
+}
+
+inline void TextRef::SetLazy(
+  uint32_t const source, uint64_t const offset, uint32_t const length) {
+  p_writable_store_->set_lazy_text(field_, position_, source, offset, length);
+}
+
+}  // namespace linea_one
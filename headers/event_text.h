@@ -0,0 +1,74 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_text.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace linea_one {
+
+class EventStore;
+
+enum class TextField : uint8_t { kHeadline, kDescription };
+
+/* Headline or description of an event, read through its EventStore.
+ * Lazily loaded texts are read on first access. */
+class ConstTextRef {
+ public:
+  ConstTextRef(const EventStore& store, TextField const field,
+    uint32_t const position)
+    : p_store_(&store), field_(field), position_(position) {}
+
+  /* Valid until the store is written or the next lazy text of the store is
+   * read: that read either loads into the arena, which may move, or, while
+   * the columns are shared with a copy, into one buffer that each such read
+   * reuses. Copy one side before comparing two texts that may be lazy. */
+  [[nodiscard]] std::string_view str() const;
+  /* Same lifetime as str */
+  [[nodiscard]] const char* c_str() const;
+  [[nodiscard]] bool empty() const { return size() == 0; }
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool IsLoaded() const;
+  operator std::string_view() const { return str(); }
+
+ protected:
+  const EventStore* p_store_;
+  TextField field_;
+  uint32_t position_;
+};
+
+class TextRef : public ConstTextRef {
+ public:
+  TextRef(EventStore& store, TextField const field, uint32_t const position)
+    : ConstTextRef(store, field, position), p_writable_store_(&store) {}
+  TextRef(const TextRef&) = default;
+
+  TextRef& operator=(std::string_view text);
+  TextRef& operator=(const TextRef& other) { return *this = other.str(); }
+  /* Points the text at a range of a source added with add_text_source. */
+  void SetLazy(uint32_t source, uint64_t offset, uint32_t length);
+
+ private:
+  EventStore* p_writable_store_;
+};
+
+}  // namespace linea_one
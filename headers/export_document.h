@@ -20,20 +20,39 @@
  */
 #pragma once
 
-#include <timeline_event.h>
+#include <event_store.h>
+#include <text_measure_cache.h>
 #include <timeline_state.h>
 #include <vector>
 #include <filesystem>
+#include <memory>
+#include <string_view>
 
 namespace linea_one {
 
+// Advance of a glyph in ImGui's default font (ProggyClean, 13 px)
+#define EXPORT_GLYPH_WIDTH 7.0f
+
 class ExportDocument {
   public:
-  ExportDocument() = default;
+  /* Without a measure text widths are estimated from the glyph count, which
+   * needs no font atlas, so exports also work headless. Measures every
+   * text and holds no state, exports may run on several threads at once. */
+  ExportDocument();
+  explicit ExportDocument(TextWidth text_width);
+  /* Shares measurements with the timeline, SetFont is up to the owner. The
+   * cache is not thread safe, nor are exports through it. */
+  explicit ExportDocument(std::shared_ptr<TextMeasureCache> p_text_cache);
+
+  static float EstimateTextWidth(std::string_view text);
 
-  std::string ExportTimelineToSVG(const std::vector<TimelineEvent>& events, const TimelineState& state);
-  void SaveTimelineAsSVG(const std::vector<TimelineEvent>& events, const TimelineState& state, const std::filesystem::path path);
+  std::string ExportTimelineToSVG(const EventStore& events, const TimelineState& state);
+  void SaveTimelineAsSVG(const EventStore& events, const TimelineState& state, const std::filesystem::path path);
 
+  private:
+  TextWidth text_width_;
+  // Null when every text is measured
+  std::shared_ptr<TextMeasureCache> p_text_cache_;
 };
 
 }
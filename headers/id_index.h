@@ -0,0 +1,79 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: id_index.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace linea_one {
+
+#define ID_INDEX_INITIAL_SLOTS 1024
+
+/* Position of every event by id, kept up to date by EventStore, and the
+ * document's id allocator. Ids are expected to be unique, with duplicates
+ * the first one stays indexed (a reader's placeholder id does not hide a
+ * real one). The next id is one past the largest id ever inserted, so ids
+ * loaded from a file are never handed out again. */
+class IdIndex {
+ public:
+  /* Does nothing when id is already indexed. */
+  void Insert(uint64_t id, uint32_t position);
+  /* These only act when id is indexed at position (from). */
+  void Remove(uint64_t id, uint32_t position);
+  void Relocate(uint64_t id, uint32_t from, uint32_t to);
+  /* Every position in [first, last] moves by delta. O(n). */
+  void Shift(uint32_t first, uint32_t last, int delta);
+  void Move(uint64_t from, uint64_t to, uint32_t position);
+  /* Remove, then every later position moves down by one. O(n). */
+  void Erase(uint64_t id, uint32_t position);
+  /* Every position from position on moves up by one, then Insert. O(n). */
+  void InsertBefore(uint64_t id, uint32_t position);
+  void Rebuild(std::span<const uint64_t> ids);
+  /* Every position p becomes moved_to[p], e.g. after the events were
+   * reordered. O(slots), no id is hashed again. */
+  void Remap(std::span<const uint32_t> moved_to);
+  void Reserve(std::size_t count);
+  /* Keeps the next id, ids stay monotonic for the document's lifetime. */
+  void Clear();
+
+  [[nodiscard]] std::optional<uint32_t> Find(uint64_t id) const;
+  uint64_t Allocate();
+
+ private:
+  static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+  [[nodiscard]] std::size_t Home(uint64_t id) const;
+  /* The slot holding id, or the empty slot it would go to. */
+  [[nodiscard]] std::size_t SlotOf(uint64_t id) const;
+  void Grow(std::size_t slots);
+
+  // Separate columns, Erase sweeps positions only
+  std::vector<uint64_t> ids_;
+  std::vector<uint32_t> positions_;
+  std::size_t count_ = 0;
+  int shift_ = 64;
+  uint64_t next_id_ = 0;
+};
+
+}  // namespace linea_one
@@ -31,6 +31,8 @@ namespace linea_one {
 #define ASCII_A 65
 #define ASCII_N 78
 #define ASCII_W 87
+#define ASCII_Y 89
+#define ASCII_Z 90
 
 class InputManager {
  public:
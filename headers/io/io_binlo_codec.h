@@ -0,0 +1,70 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_binlo_codec.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace linea_one::io {
+
+#define BINLO_MAGIC "LINEAONE"
+#define BINLO_VERSION 2
+#define BINLO_FLAG_EXPANDED 0x01
+
+/* Layout of a .binlo file, host byte order (little-endian). Every section
+ * starts on an 8 byte boundary:
+ *   header | ids u64[n] | dates i64[n] | flags u8[n] |
+ *   headline offsets u64[n + 1] | description offsets u64[n + 1] | blob
+ * Dates are EventDate keys, version 1 files hold i32 years there instead.
+ * Text offsets are relative to the blob, text i is [offsets[i],
+ * offsets[i + 1]). */
+struct BinloHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t event_count;
+  float zoom;
+  float offset;
+  uint64_t name_offset;
+  uint64_t name_length;
+  uint64_t ids_offset;
+  uint64_t dates_offset;
+  uint64_t flags_offset;
+  uint64_t headline_offsets_offset;
+  uint64_t description_offsets_offset;
+  uint64_t blob_offset;
+  uint64_t blob_size;
+};
+
+class BinloCodec {
+ public:
+  /* Maps the file, ids, dates and flags are copied out of the columns,
+   * headlines and descriptions stay in the mapping until they are touched. */
+  static std::optional<Document> Read(const std::filesystem::path& path);
+  /* Writes next to the target and renames over it, so a mapping of the old
+   * file held by lazily loaded texts stays valid. */
+  static bool Write(const Document& document, const std::filesystem::path& path);
+};
+
+}  // namespace linea_one::io
@@ -0,0 +1,60 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_document_format.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <filesystem>
+
+namespace linea_one::io {
+
+#define JSONLO_EXTENSION ".jsonlo"
+#define BINLO_EXTENSION ".binlo"
+#define JSONLO_GZ_EXTENSION ".jsonlo.gz"
+
+enum class DocumentFormat { kJsonlo = 0, kBinlo, kJsonloGz };
+
+inline const char* ExtensionOf(DocumentFormat const format) {
+  switch (format) {
+    case DocumentFormat::kBinlo: return BINLO_EXTENSION;
+    case DocumentFormat::kJsonloGz: return JSONLO_GZ_EXTENSION;
+    default: return JSONLO_EXTENSION;
+  }
+}
+
+inline bool IsJsonloGzPath(const std::filesystem::path& path) {
+  return path.extension() == ".gz" &&
+         path.stem().extension() == JSONLO_EXTENSION;
+}
+
+/* Codec of a document is picked by the extension, .jsonlo is the default. */
+inline DocumentFormat FormatFromPath(const std::filesystem::path& path) {
+  if (IsJsonloGzPath(path)) {
+    return DocumentFormat::kJsonloGz;
+  }
+  return path.extension() == BINLO_EXTENSION ? DocumentFormat::kBinlo
+                                             : DocumentFormat::kJsonlo;
+}
+
+inline bool IsDocumentPath(const std::filesystem::path& path) {
+  return path.extension() == JSONLO_EXTENSION ||
+         path.extension() == BINLO_EXTENSION || IsJsonloGzPath(path);
+}
+
+}  // namespace linea_one::io
@@ -0,0 +1,34 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_file_sync.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <filesystem>
+
+namespace linea_one::io {
+
+/* Flushes the file contents to the storage device. */
+bool SyncFile(const std::filesystem::path& path);
+/* Syncs temp_path and renames it over path. The temp file is removed when
+ * anything fails, so path always holds either the old or the new contents. */
+bool CommitTempFile(
+  const std::filesystem::path& temp_path, const std::filesystem::path& path);
+
+}  // namespace linea_one::io
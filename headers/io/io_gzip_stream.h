@@ -0,0 +1,64 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_gzip_stream.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+namespace linea_one::io {
+
+// Size of the uncompressed side buffer and of zlib's own buffer
+#define GZIP_BUFFER_BYTES (256 * 1024)
+
+/* Stream buffer over a gzip file, so std::istream and std::ostream users
+ * inflate or deflate on the fly. Only one direction per instance. */
+class GzipStreamBuf final : public std::streambuf {
+ public:
+  static std::unique_ptr<GzipStreamBuf> Open(
+    const std::filesystem::path& path, std::ios::openmode mode);
+  /* Works on a duplicate of the descriptor (stdin, stdout, ...), closing the
+   * buffer leaves the original open. */
+  static std::unique_ptr<GzipStreamBuf> Open(
+    int descriptor, std::ios::openmode mode);
+  ~GzipStreamBuf() override;
+  GzipStreamBuf(const GzipStreamBuf&) = delete;
+  GzipStreamBuf& operator=(const GzipStreamBuf&) = delete;
+
+  /* Flushes pending output and writes the gzip trailer. */
+  bool Close();
+
+ protected:
+  int_type underflow() override;
+  int_type overflow(int_type character) override;
+  int sync() override;
+
+ private:
+  GzipStreamBuf(void* p_file, bool writing);
+  bool FlushBuffer();
+
+  void* p_file_;
+  bool writing_;
+  std::vector<char> buffer_;
+};
+
+}  // namespace linea_one::io
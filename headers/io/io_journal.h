@@ -0,0 +1,107 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_journal.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace linea_one::io {
+
+#define JOURNAL_EXTENSION ".journal"
+#define JOURNAL_MAGIC "LINEAJNL"
+// Bumped whenever a record type is added, older builds then ignore the file
+#define JOURNAL_VERSION 2
+// Oldest journal whose frames are still replayed, appends need the current
+#define JOURNAL_MIN_VERSION 1
+// Compaction starts once the journal is bigger than this and half the base
+#define JOURNAL_COMPACT_MIN_BYTES (4ull * 1024 * 1024)
+
+/* Size and modification time of the base file a journal belongs to. */
+struct JournalFingerprint {
+  uint64_t size = 0;
+  int64_t modified = 0;
+  bool operator==(const JournalFingerprint&) const = default;
+};
+
+/* Where a compaction started, frames past length were appended during it. */
+struct JournalMark {
+  JournalFingerprint fingerprint;
+  uint64_t length = 0;
+};
+
+/* Append-only sidecar log of saves, "<base>.journal". Each save is one
+ * checksummed frame of idempotent records (event upsert, delete, order,
+ * state), so replaying a frame that is already part of the base is
+ * harmless. The journal is bound to the size and mtime of its base file and
+ * is ignored when the base was replaced by something else. */
+class Journal {
+ public:
+  static std::filesystem::path PathFor(const std::filesystem::path& base_path);
+  static JournalFingerprint FingerprintOf(
+    const std::filesystem::path& base_path);
+  /* One checksummed frame with the records of the delta, ready to append. */
+  static std::string EncodeFrame(
+    const Document& document, const DocumentDelta& delta);
+  /* Applies complete frames, returns how many bytes of them were valid. A
+   * torn or garbage tail just ends the frames, nullopt means a frame passed
+   * its checksum but could not be read. */
+  static std::optional<uint64_t> ApplyFrames(
+    Document& document, const char* p_data, uint64_t size);
+
+  /* Starts an empty journal for the base file as it is on disk now. */
+  bool Reset(const std::filesystem::path& base_path);
+  [[nodiscard]] bool IsBound(const std::filesystem::path& base_path,
+    uint32_t min_version = JOURNAL_VERSION);
+  bool Append(const Document& document, const DocumentDelta& delta,
+    const std::filesystem::path& base_path);
+  bool AppendFrame(
+    const std::string& frame, const std::filesystem::path& base_path);
+  /* Applies frames up to limit bytes, a torn tail is cut off. Returns false
+   * when there is no journal bound to the base or a frame is unreadable, the
+   * file is then left as it is. */
+  bool Replay(Document& document, const std::filesystem::path& base_path,
+    uint64_t limit = UINT64_MAX);
+  [[nodiscard]] uint64_t Size(const std::filesystem::path& base_path);
+  [[nodiscard]] std::optional<JournalMark> Mark(
+    const std::filesystem::path& base_path);
+  /* Moves the compacted base in place and keeps only the frames appended
+   * after mark. Gives up when the base was rewritten meanwhile. */
+  bool Rebind(const std::filesystem::path& base_path,
+    const std::filesystem::path& compacted_path, const JournalMark& mark);
+  void Remove(const std::filesystem::path& base_path);
+  /* Held around full writes so they do not interleave with a compaction. */
+  [[nodiscard]] std::unique_lock<std::recursive_mutex> Lock();
+
+ private:
+  std::optional<JournalFingerprint> ReadHeader(
+    const std::filesystem::path& journal_path, uint32_t min_version);
+  bool WriteHeader(const std::filesystem::path& journal_path,
+    const JournalFingerprint& fingerprint);
+
+  std::recursive_mutex mutex_;
+};
+
+}  // namespace linea_one::io
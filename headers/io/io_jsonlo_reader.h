@@ -0,0 +1,49 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_jsonlo_reader.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <optional>
+
+namespace linea_one::io {
+
+// Smallest possible serialized event, used to bound the reserved capacity:
+// {"Id":0,"Year":0,"Headline":"","Description":"","Expanded":false}
+#define JSONLO_MIN_EVENT_BYTES 64
+// Files from this size on are opened with ReadLazy
+#define JSONLO_LAZY_MIN_BYTES (4ull * 1024 * 1024)
+
+class JsonloReader {
+ public:
+  /* Streams the document straight into Document::events without building a
+   * json DOM. size_hint is the byte size of the input, 0 when unknown. */
+  static std::optional<Document> Read(
+    std::istream& stream, std::uintmax_t size_hint = 0);
+  /* Like Read, but descriptions only keep their position in the file, which
+   * stays mapped. A description is read and unescaped on first access. */
+  static std::optional<Document> ReadLazy(const std::filesystem::path& path);
+};
+
+}  // namespace linea_one::io
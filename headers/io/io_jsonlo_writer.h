@@ -0,0 +1,47 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_jsonlo_writer.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document.h>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace linea_one::io {
+
+// Fixed part of one serialized event plus room for the widest numbers
+#define JSONLO_EVENT_OVERHEAD_BYTES 160
+// Buffered output handed to the stream at once by the streaming Write
+#define JSONLO_WRITE_CHUNK_BYTES (1024 * 1024)
+
+class JsonloWriter {
+ public:
+  /* Serializes the document in one pass into a buffer reserved up front.
+   * Strings are escaped per RFC 8259, invalid UTF-8 becomes U+FFFD. */
+  static std::string Write(const Document& document);
+  /* Same output, passed to the stream in chunks instead of one buffer. */
+  static bool Write(const Document& document, std::ostream& stream);
+  /* Output size assuming no string needs escaping. */
+  static std::size_t EstimateSize(const Document& document);
+};
+
+}  // namespace linea_one::io
@@ -0,0 +1,52 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_mapped_file.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+
+namespace linea_one::io {
+
+/* Read-only memory mapping of a whole file. Pages are read by the OS on first
+ * access, so opening does not depend on the file size. */
+class MappedFile {
+ public:
+  static std::shared_ptr<MappedFile> Open(const std::filesystem::path& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] const std::byte* Data() const;
+  [[nodiscard]] std::size_t Size() const;
+
+ private:
+  MappedFile() = default;
+
+  const std::byte* p_data_ = nullptr;
+  std::size_t size_ = 0;
+#if defined(_WIN32) || defined(_WIN64)
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace linea_one::io
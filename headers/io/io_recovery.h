@@ -0,0 +1,66 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_recovery.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <document.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace linea_one::io {
+
+#define RECOVERY_EXTENSION ".recovery"
+#define RECOVERY_MAGIC "LINEAREC"
+// Carries journal frames, so it is bumped along with JOURNAL_VERSION
+#define RECOVERY_VERSION 2
+#define RECOVERY_MIN_VERSION 1
+#define AUTOSAVE_DEFAULT_INTERVAL_SECONDS 60
+
+struct RecoveredDocument {
+  std::filesystem::path recovery_path;
+  // Empty for a document that was never saved
+  std::filesystem::path source_path;
+  std::string name;
+};
+
+/* Crash recovery files of unsaved documents. A recovery file names the
+ * document it belongs to, followed by journal frames of everything edited
+ * since that document was last on disk. Documents that were never saved
+ * start with a frame holding all their events. */
+class Recovery {
+ public:
+  static std::filesystem::path Directory();
+  static std::filesystem::path NewPath();
+  static bool Start(const std::filesystem::path& recovery_path,
+    const std::filesystem::path& source_path, const std::string& name);
+  static bool Append(
+    const std::filesystem::path& recovery_path, const std::string& frame);
+  static std::vector<RecoveredDocument> List();
+  /* Applies the frames on top of the source document (or an empty one).
+   * Fails on a frame it cannot read. An older file is upgraded, since the
+   * restored document keeps appending current frames to it. */
+  static bool Restore(
+    Document& document, const std::filesystem::path& recovery_path);
+  static void Remove(const std::filesystem::path& recovery_path);
+};
+
+}  // namespace linea_one::io
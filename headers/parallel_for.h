@@ -0,0 +1,39 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: parallel_for.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace linea_one {
+
+// Fewer items than this are not worth a thread
+#define PARALLEL_FOR_MIN_ITEMS 65536
+
+/* Calls task(part) once for every part in [0, parts), spread over the
+ * hardware threads. The calling thread takes parts too and returns once
+ * every part is done. */
+void ParallelFor(std::size_t parts, const std::function<void(std::size_t)>& task);
+/* How many parts count items split into, one per thread at most and never
+ * smaller than PARALLEL_FOR_MIN_ITEMS, except for a single part. */
+[[nodiscard]] std::size_t ParallelParts(std::size_t count);
+
+}  // namespace linea_one
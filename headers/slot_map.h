@@ -0,0 +1,116 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: slot_map.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace linea_one {
+
+struct SlotHandle {
+  uint32_t index = 0;
+  // Zero never names a live slot, so a default handle is empty
+  uint32_t generation = 0;
+
+  bool operator==(const SlotHandle&) const = default;
+  explicit operator bool() const { return generation != 0; }
+};
+
+struct SlotHandleHash {
+  std::size_t operator()(SlotHandle const handle) const {
+    return std::hash<uint64_t>()(
+      static_cast<uint64_t>(handle.generation) << 32 | handle.index);
+  }
+};
+
+/* Values keep their address from Emplace until Erase, and a handle to an
+ * erased value stops resolving even once its slot is reused, because every
+ * Erase moves the slot to a new generation. Lookup, insertion and removal
+ * are constant time. */
+template <typename T>
+class SlotMap {
+ public:
+  template <typename... Args>
+  SlotHandle Emplace(Args&&... args) {
+    uint32_t index;
+    if (free_.empty()) {
+      index = static_cast<uint32_t>(slots_.size());
+      // Growing a deque at the back leaves the other elements in place
+      slots_.emplace_back();
+    } else {
+      index = free_.back();
+      free_.pop_back();
+    }
+    auto& slot = slots_[index];
+    slot.value.emplace(std::forward<Args>(args)...);
+    ++size_;
+    return {index, slot.generation};
+  }
+
+  /* False when the handle is empty or stale. */
+  bool Erase(SlotHandle const handle) {
+    if (!Get(handle)) {
+      return false;
+    }
+    auto& slot = slots_[handle.index];
+    slot.value.reset();
+    if (++slot.generation == 0) {
+      slot.generation = 1;
+    }
+    free_.push_back(handle.index);
+    --size_;
+    return true;
+  }
+
+  [[nodiscard]] T* Get(SlotHandle const handle) {
+    if (handle.index >= slots_.size()) {
+      return nullptr;
+    }
+    auto& slot = slots_[handle.index];
+    return slot.generation == handle.generation && slot.value
+             ? &*slot.value
+             : nullptr;
+  }
+  [[nodiscard]] const T* Get(SlotHandle const handle) const {
+    return const_cast<SlotMap*>(this)->Get(handle);
+  }
+  [[nodiscard]] bool Contains(SlotHandle const handle) const {
+    return Get(handle) != nullptr;
+  }
+  [[nodiscard]] std::size_t Size() const { return size_; }
+
+ private:
+  struct Slot {
+    uint32_t generation = 1;
+    std::optional<T> value;
+  };
+
+  std::deque<Slot> slots_;
+  std::vector<uint32_t> free_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace linea_one
@@ -0,0 +1,100 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: text_arena.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linea_one {
+
+// Compaction waits until at least this much (and half the arena) is garbage
+#define TEXT_ARENA_COMPACT_MIN_BYTES (1024 * 1024)
+#define TEXT_ARENA_INITIAL_SLOTS 1024
+
+/* Backing storage of texts that are not loaded yet (mapped file, ...). */
+class TextSource {
+ public:
+  virtual ~TextSource() = default;
+  /* Replaces text, whose capacity is reused across calls. */
+  virtual void Fetch(uint64_t offset, uint64_t length, std::string& text) const = 0;
+};
+
+/* Position of a text. source 0 is the arena, otherwise the text still lives
+ * in source - 1 of the arena's sources and length is its stored size. */
+struct TextHandle {
+  uint64_t offset = 0;
+  uint32_t length = 0;
+  uint32_t source = 0;
+};
+
+/* Texts of one document packed into a single buffer, each followed by a
+ * '\0' so c_str() needs no copy. Identical texts are stored once. Texts are
+ * only appended, replaced ones stay behind as garbage until Compact.
+ *
+ * Views and c_str() pointers are valid until the next Intern, Load or
+ * Compact. Const members may run alongside each other. */
+class TextArena {
+ public:
+  TextHandle Intern(std::string_view text);
+  /* Index for lazy handles, see TextHandle::source. */
+  uint32_t AddSource(std::shared_ptr<const TextSource> p_source);
+  /* Text of a loaded handle, see TextHandle::source. */
+  [[nodiscard]] std::string_view View(const TextHandle& handle) const;
+  /* Interns the text of a lazy handle, returns its loaded handle. */
+  TextHandle Load(const TextHandle& handle);
+  /* Reads the text of a lazy handle into text, leaving the arena as is. */
+  void Fetch(const TextHandle& handle, std::string& text) const;
+  /* The text of handle is no longer used by it. */
+  void Release(const TextHandle& handle);
+  [[nodiscard]] bool NeedsCompaction() const;
+  /* Rebuilds the arena from the texts the columns still point to. */
+  void Compact(std::initializer_list<std::span<TextHandle>> columns);
+  void Reserve(std::size_t bytes);
+  void Clear();
+  [[nodiscard]] std::size_t Size() const;
+
+ private:
+  static constexpr uint64_t kEmptySlot = UINT64_MAX;
+
+  struct Slot {
+    uint64_t offset = kEmptySlot;
+    uint32_t length = 0;
+    uint32_t hash = 0;
+  };
+
+  [[nodiscard]] std::string_view Text(uint64_t offset, uint32_t length) const;
+  void Grow();
+
+  std::vector<char> buffer_;
+  std::vector<Slot> slots_;
+  std::size_t interned_ = 0;
+  std::size_t garbage_ = 0;
+  std::vector<std::shared_ptr<const TextSource>> sources_;
+  std::string fetched_;
+};
+
+}  // namespace linea_one
@@ -0,0 +1,93 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: text_measure_cache.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <event_date.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace linea_one {
+
+// Entries per map before it starts over, bounds memory when many distinct
+// texts pass through, e.g. while typing a long headline
+#define TEXT_MEASURE_CACHE_MAX_ENTRIES (1 << 20)
+
+using TextWidth = std::function<float(std::string_view text)>;
+
+struct MeasuredText {
+  std::string text;
+  float width;
+};
+
+/* Widths of texts measured once and kept across frames. Texts are keyed by
+ * their content, so an edited headline is simply a new key and unchanged
+ * ones are never measured again. Date labels are keyed by the dates and
+ * keep their formatted text too. Everything is dropped when the font
+ * changes. Returned labels stay valid until the next call. Not thread
+ * safe, one per thread that measures. */
+class TextMeasureCache {
+ public:
+  explicit TextMeasureCache(TextWidth measure);
+
+  /* Any value identifying the font and its size, measurements taken with
+   * another font are discarded */
+  void SetFont(uint64_t const font);
+  [[nodiscard]] float Width(std::string_view text);
+  /* FormatDate(date) */
+  [[nodiscard]] const MeasuredText& DateLabel(EventDate const date);
+  /* FormatDate of both, "first - last" when they differ */
+  [[nodiscard]] const MeasuredText& DateLabel(
+    EventDate const first, EventDate const last);
+  /* Counts like cluster sizes */
+  [[nodiscard]] const MeasuredText& NumberLabel(uint64_t const number);
+  [[nodiscard]] std::size_t Size() const;
+  void Clear();
+
+ private:
+  struct TextHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view text) const {
+      return std::hash<std::string_view>{}(text);
+    }
+  };
+  struct PairHash {
+    std::size_t operator()(const std::pair<int64_t, int64_t>& key) const {
+      return std::hash<int64_t>{}(key.first * 31 + key.second);
+    }
+  };
+
+  const MeasuredText& Label(
+    std::pair<int64_t, int64_t> const key, std::string text);
+
+  TextWidth measure_;
+  uint64_t font_ = 0;
+  std::unordered_map<std::string, float, TextHash, std::equal_to<>> widths_;
+  std::unordered_map<std::pair<int64_t, int64_t>, MeasuredText, PairHash>
+    labels_;
+  std::unordered_map<uint64_t, MeasuredText> numbers_;
+};
+
+}  // namespace linea_one
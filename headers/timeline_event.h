@@ -20,17 +20,22 @@
  */
 #pragma once
 
+#include <copy_counter.h>
+#include <event_date.h>
+
 #include <cstdint>
 #include <iostream>
+#include <string>
 
 namespace linea_one {
 
 struct TimelineEvent {
   uint64_t id;
-  int year;
+  EventDate date;
   std::string headline;
   bool expanded;
   std::string description;
+  [[no_unique_address]] CopyCounter<TimelineEvent> copy_counter;
 };
 
 }  // namespace linea_one
@@ -22,12 +22,13 @@
 #include <document.h>
 #include <document_manager.h>
 #include <svg_icon.h>
+#include <text_measure_cache.h>
+#include <ui/ui_document_view.h>
 #include <ui/ui_draw_timeline.h>
 
-#include <atomic>
-#include <functional>
 #include <memory>
-#include <thread>
+#include <optional>
+#include <unordered_map>
 
 #define EVENT_CONTAINER_HEIGHT 105
 #define EVENT_CONTAINER_HEIGHT_EXPANDED 139
@@ -39,41 +40,48 @@
 #define ICON_PADDING 8.0f
 #define BUFFER_HEADLINE_SIZE 256
 #define BUFFER_DESCRIPTION_SIZE 2048
-#define MIN_SIZE_LEFT_PANEL 400.0f
 
 namespace linea_one::ui {
 
-enum e_dating { kBC = 0, kAC };
-
 class UiDocumentTab {
  public:
   explicit UiDocumentTab(const std::shared_ptr<SDL_Renderer>& p_renderer,
-    std::shared_ptr<DocumentManager> p_doc_man);
+    std::shared_ptr<DocumentManager> p_doc_man,
+    std::shared_ptr<TextMeasureCache> p_text_cache);
   ~UiDocumentTab();
-  void Render(Document& document, uint64_t index);
+  void Render(Document& document, DocumentHandle const handle);
   void AddNewEvent(Document& document);
-  void StartSort(Document& document, uint64_t index,
-    const std::function<void(Document& document, uint64_t index)>& callback);
   [[nodiscard]] bool IsSorting();
+  /* Forgets the view of every document that is no longer open */
+  void ReleaseClosedViews();
 
  private:
-  inline void RenderLeftBox(Document& document, uint64_t index);
+  inline DocumentView& View(DocumentHandle const handle);
+  inline void RenderLeftBox(Document& document, DocumentHandle const handle);
+  inline void RenderEventList(Document& document);
   inline void RenderRightBox(Document& document);
   inline void RenderEventBox(
-    Document& document, TimelineEvent& event, uint64_t order);
+    Document& document, EventRef event, uint64_t order);
   inline void RenderExpanderButton(
-    TimelineEvent& event, float width, float height);
-  inline void RenderDateInput(TimelineEvent& event, float width);
-  inline void RenderHeadlineInput(TimelineEvent& event, float width);
+    EventRef event, float width, float height);
+  inline void RenderDateInput(EventRef event, float width);
+  inline void RenderHeadlineInput(EventRef event, float width);
   inline void RenderDescriptionInput(
-    TimelineEvent& event, float width, uint64_t order);
-  inline void ParseYear(TimelineEvent& event, uint64_t index);
-  inline void DeleteEvent(Document& doc, const TimelineEvent& event);
+    EventRef event, float width, uint64_t order);
+  inline void ParseYear(EventRef event, uint64_t index);
+  inline void DeleteEvent(Document& doc, EventRef event);
   inline void SwapEvents(
     Document& document, uint64_t source_index, uint64_t target_index);
-  inline void RenderSort(Document& document, uint64_t index,
-    ImVec2 content_size);
+  inline void RenderSort(
+    Document& document, DocumentHandle const handle, ImVec2 content_size);
+  /* Moves an event whose date changed to where it sorts */
+  inline void Reposition(Document& document, uint64_t id);
+  /* Sorts a document in auto order mode that is out of order */
+  inline void KeepOrder(Document& document, DocumentHandle const handle);
   inline void DocumentHasChanged();
+  inline void EventHasChanged(EventRef event);
+  inline void DateHasChanged(EventRef event);
+  inline DocumentHistory& History();
 
   std::shared_ptr<SDL_Renderer> p_renderer_;
   std::shared_ptr<svg::SvgIcon> p_drag_icon_;
@@ -81,15 +89,20 @@ class UiDocumentTab {
   std::shared_ptr<svg::SvgIcon> p_arrow_drop_up_icon_;
   std::shared_ptr<svg::SvgIcon> p_arrow_drop_down_icon_;
   std::shared_ptr<DocumentManager> p_doc_man_;
+  std::shared_ptr<TextMeasureCache> p_text_cache_;
   char* a_buffer_headline_;
   char* a_buffer_description_;
-  int index_bc_ac_ = kAC;
   const char* bc_ac_items_[2] = {"BC", "AC"};
-  int year_, new_year_;
-  uint64_t last_id_ = 0;
-  float left_panel_width_ = MIN_SIZE_LEFT_PANEL;
-  std::atomic<bool> is_sorting_{false};
-  std::jthread sorting_thread_;
+  std::unordered_map<DocumentHandle, DocumentView, SlotHandleHash> views_;
+  // View of the document being rendered
+  DocumentView* p_view_ = nullptr;
+  DocumentHandle shown_document_;
+  // Measured from the drawn rows, the same for every document
+  float row_gap_ = 0.0f;
+  // Date changed this frame in auto order mode, moved once the list is drawn
+  std::optional<uint64_t> moved_event_;
+  // Whose date field is being dragged
+  std::optional<uint64_t> active_event_;
 };
 
 }  // namespace linea_one::ui
@@ -0,0 +1,106 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: ui_document_view.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <event_store.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#define MIN_SIZE_LEFT_PANEL 400.0f
+// Each level's bins span 2^bits times the years of the one below, the top
+// level splits the whole int range of years into a few bins
+#define TIMELINE_BIN_LEVEL_BITS 2
+#define TIMELINE_BIN_LEVELS 16
+
+namespace linea_one::ui {
+
+enum e_dating { kBC = 0, kAC };
+
+/* Where each row of the event list sits, rebuilt only when the document's
+ * revision or the row heights change. */
+class EventListLayout {
+ public:
+  [[nodiscard]] bool IsCurrent(
+    uint64_t const revision, std::size_t const rows, float const gap) const;
+  void Rebuild(const EventStore& events, uint64_t const revision,
+    float const collapsed_height, float const expanded_height,
+    float const gap);
+  /* Rows overlapping [top, bottom), as a half open index range */
+  [[nodiscard]] std::pair<std::size_t, std::size_t> Visible(
+    float const top, float const bottom) const;
+  [[nodiscard]] float Top(std::size_t const row) const;
+  [[nodiscard]] float Height() const;
+
+ private:
+  uint64_t revision_ = 0;
+  float gap_ = 0.0f;
+  // One more than there are rows, the last one is the list's height
+  std::vector<float> tops_;
+};
+
+/* Event counts over bins of 1, 4, 16, ... years, so a zoomed out timeline
+ * draws one marker per bin instead of one per event. Rebuilt from the year
+ * index when the document's revision changes, O(years), not O(events). */
+class TimelineBins {
+ public:
+  struct Bin {
+    // year >> level * TIMELINE_BIN_LEVEL_BITS
+    int key;
+    int first_year;
+    int last_year;
+    uint32_t count;
+    // An event of the bin, the one drawn when it is alone
+    uint32_t position;
+    double year_sum;
+  };
+
+  [[nodiscard]] bool IsCurrent(
+    uint64_t const revision, std::size_t const events) const;
+  void Rebuild(const EventStore& events, uint64_t const revision);
+  /* Finest level whose bins are at least spacing wide */
+  [[nodiscard]] static int Level(float const year_width, float const spacing);
+  /* Bins of the level holding years in [first_year, last_year] */
+  [[nodiscard]] std::span<const Bin> Between(
+    int const level, int const first_year, int const last_year) const;
+
+ private:
+  uint64_t revision_ = 0;
+  std::size_t events_ = 0;
+  bool built_ = false;
+  std::array<std::vector<Bin>, TIMELINE_BIN_LEVELS> levels_;
+};
+
+/* What one open document looks like on screen. Kept for as long as the
+ * document is open, so switching tabs leaves it as it was. */
+struct DocumentView {
+  float left_panel_width = MIN_SIZE_LEFT_PANEL;
+  int index_bc_ac = kAC;
+  bool auto_order = false;
+  int new_year = 1999;
+  float list_scroll_y = 0.0f;
+  EventListLayout list_layout;
+  TimelineBins timeline_bins;
+};
+
+}  // namespace linea_one::ui
@@ -21,10 +21,17 @@
 #pragma once
 
 #include <document.h>
+#include <text_measure_cache.h>
 #include <timeline_state.h>
+#include <ui/ui_document_view.h>
 
 namespace linea_one::ui {
 
+// Pixels one year needs on screen before events are placed by month and day
+#define TIMELINE_FINE_YEAR_WIDTH 120.0f
+// Closest two markers get, nearer events are drawn as one with their count
+#define TIMELINE_CLUSTER_SPACING 40.0f
+
 struct TextPosition {
   ImVec2 pos;
   float width;
@@ -33,11 +40,14 @@ struct TextPosition {
 class UiDrawTimeline {
  public:
   UiDrawTimeline() = default;
-  static void Render(const std::vector<TimelineEvent>& events, TimelineState& state);
+  static void Render(const EventStore& events, TimelineState& state,
+    const TimelineBins& bins, TextMeasureCache& text_cache);
 
 private:
-  static void DrawTimeline(const std::vector<TimelineEvent>& events, TimelineState& state);
-  static float MapYearToPixel(int year, const TimelineState& state, float startX, float width);
+  static void DrawTimeline(const EventStore& events, TimelineState& state,
+    const TimelineBins& bins, TextMeasureCache& text_cache);
+  static float MapYearToPixel(double year, const TimelineState& state, float startX, float width);
+  static float MapPixelToYear(float x, const TimelineState& state, float startX, float width);
   static void HandleInteraction(TimelineState& state, uint64_t events_size);
 };
 
@@ -22,8 +22,10 @@
 #include <imgui.h>
 #include <svg_icon.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <string_view>
 
 namespace linea_one::ui::elements {
 extern void VerticalSeparator(float height, float x_offset = 0.0f,
@@ -42,4 +44,9 @@ extern bool RenderIconButton(
 void RenderSpinner(const char* label, const char* display_text, float radius, int thickness, float speed = 1.0f, float arc_length = 0.8f,
   ImVec4 color = ImGui::GetStyle().Colors[ImGuiCol_Button]);
 
+/* Width of the text in the current font */
+float MeasureText(std::string_view text);
+/* Changes with the current font and its size, for TextMeasureCache */
+uint64_t FontKey();
+
 }  // namespace linea_one::ui::elements
\ No newline at end of file
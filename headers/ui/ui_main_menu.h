@@ -38,6 +38,7 @@ class UiMainMenu {
   void SetShowSaveDialog(const bool show_save_dialog);
   void SetShowLoadDialog(const bool show_save_dialog);
   void SetShowExportDialog(const bool show_save_dialog);
+  void SetEditEnabled(const bool edit_enabled);
 
  private:
   void NewFile() const;
@@ -50,6 +51,7 @@ class UiMainMenu {
   bool show_load_dialog_ = false;
   bool show_export_dialog_ = false;
   bool stop_rendering_ = false;
+  bool edit_enabled_ = true;
 
 };
 
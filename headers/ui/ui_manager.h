@@ -22,6 +22,7 @@
 #include <document.h>
 #include <document_manager.h>
 #include <input_manager.h>
+#include <text_measure_cache.h>
 #include <ui/ui_document_tab.h>
 #include <ui/ui_main_menu.h>
 
@@ -39,7 +40,7 @@ class UiManager {
   void RenderMenu();
   void RenderContent();
   void RenderTabs();
-  void RenderTabContent(Document& doc, uint64_t index) const;
+  void RenderTabContent(Document& doc, DocumentHandle const handle) const;
   void SetShowUnsavedDialog(const bool show_unsaved_dialog);
   [[nodiscard]] bool GetStopRendering() const;
   void SetStopRendering(const bool stop_rendering);
@@ -48,6 +49,8 @@ class UiManager {
 
  private:
   std::shared_ptr<DocumentManager> p_doc_man_;
+  // Shared by the timeline and the export
+  std::shared_ptr<TextMeasureCache> p_text_cache_;
   std::unique_ptr<UiMainMenu> p_main_menu_;
   std::shared_ptr<UiDocumentTab> p_doc_tab_;
   std::unique_ptr<UiModalDialogs> p_modal_dialogs_;
@@ -60,6 +63,7 @@ class UiManager {
   bool stop_rendering_ = false;
   bool new_tab_request_ = false;
   bool sort_request_ = false;
+  bool history_request_ = false;
 };
 
 }  // namespace linea_one::ui
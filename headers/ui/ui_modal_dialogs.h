@@ -28,12 +28,14 @@ namespace linea_one::ui {
 
 class UiModalDialogs {
  public:
-  explicit UiModalDialogs(const std::shared_ptr<DocumentManager> &p_doc_man);
+  UiModalDialogs(const std::shared_ptr<DocumentManager> &p_doc_man,
+    const std::shared_ptr<TextMeasureCache> &p_text_cache);
 
   void RenderUnsavedChanges();
   void RenderSaveDialog();
   void RenderLoadDialog();
   void RenderExportDialog();
+  void RenderRecoveryDialog();
   void RefreshDirectoryContents();
 
   void SetShowUnsavedDialog(const bool show_unsaved_dialog);
@@ -44,20 +46,27 @@ class UiModalDialogs {
   [[nodiscard]] bool GetShowSaveDialog() const;
   [[nodiscard]] bool GetShowLoadDialog() const;
   [[nodiscard]] bool GetShowExportDialog() const;
+  [[nodiscard]] bool GetShowRecoveryDialog() const;
 
 
  private:
   std::shared_ptr<DocumentManager> p_doc_man_;
+  std::shared_ptr<TextMeasureCache> p_text_cache_;
   bool show_unsaved_dialog_;
   bool show_save_dialog_;
   bool show_load_dialog_ = false;
   bool show_export_dialog_ = false;
+  bool show_recovery_dialog_ = false;
+  std::vector<io::RecoveredDocument> recoveries_;
   std::filesystem::path current_path_;
- std::optional<std::filesystem::path> selected_file_;
+ std::vector<std::filesystem::path> selected_files_;
   std::vector<std::string> dir_contents_;
   std::string file_name_ = "Untitled.jsonlo";
   char file_name_buffer_[256];
   int selected_index_ = -1;
+  const char* format_items_[3] = {"LineaOne (*.jsonlo)",
+    "LineaOne binary (*.binlo)", "LineaOne compressed (*.jsonlo.gz)"};
+  int index_format_ = 0;
   ExportDocument export_doc_;
 };
 
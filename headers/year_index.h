@@ -0,0 +1,75 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: year_index.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <event_date.h>
+
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace linea_one {
+
+/* Positions of events grouped by the year of their date, kept up to date
+ * by EventStore on every insert, delete and date edit. The smallest and
+ * largest year are the ends of the map and a year interval is found with
+ * two lookups, so callers visit only the years they need instead of
+ * scanning the date column. Positions inside a year stay in document
+ * order. */
+class YearIndex {
+ public:
+  using Groups = std::map<int, std::vector<uint32_t>>;
+  using Range = std::ranges::subrange<Groups::const_iterator>;
+
+  void Insert(int year, uint32_t position);
+  void Remove(int year, uint32_t position);
+  void Move(int from, int to, uint32_t position);
+  /* The event at position from is now at to, nothing else moves. */
+  void Relocate(int year, uint32_t from, uint32_t to);
+  /* Every position in [first, last] moves by delta (1 or -1), which has to
+   * leave them in order. O(n). */
+  void Shift(uint32_t first, uint32_t last, int delta);
+  /* Remove, then every later position moves down by one. O(n). */
+  void Erase(int year, uint32_t position);
+  /* Every position from position on moves up by one, then Insert. O(n). */
+  void InsertBefore(int year, uint32_t position);
+  void Swap(int year_a, uint32_t a, int year_b, uint32_t b);
+  void Rebuild(std::span<const EventDate> dates);
+  /* Every position p becomes moved_to[p], the ones mapped to UINT32_MAX are
+   * dropped. moved_to keeps the order of what it keeps, like compacting a
+   * column does. O(n), no year is looked up again. */
+  void Compact(std::span<const uint32_t> moved_to);
+  void Clear();
+
+  [[nodiscard]] bool Empty() const;
+  [[nodiscard]] int Min() const;
+  [[nodiscard]] int Max() const;
+  /* Years in [first, last] with their positions, in year order. */
+  [[nodiscard]] Range Between(int first, int last) const;
+  [[nodiscard]] const Groups& All() const;
+
+ private:
+  Groups groups_;
+};
+
+}  // namespace linea_one
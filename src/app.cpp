@@ -72,6 +72,7 @@ void App::Run() {
     if (p_input_man_->HandleShortcuts() == ASCII_W) {
       p_renderer_->SetShowUnsavedDialog(true);
     }
+    p_doc_man_->Update();
     Update();
     p_renderer_->Render();
 
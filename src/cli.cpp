@@ -0,0 +1,305 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: cli.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <cli.h>
+#include <io/io_gzip_stream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace linea_one {
+
+int Cli::Run(int const argc, char** argv) {
+  std::ios::sync_with_stdio(false);
+  if (!ParseArguments({argv + std::min(argc, 1), argv + argc})) {
+    PrintUsage();
+    return CLI_EXIT_USAGE;
+  }
+  if (options_.inputs.front() == CLI_STDIO_PATH) {
+    return ProcessStdio() ? CLI_EXIT_OK : CLI_EXIT_FAILED;
+  }
+
+  if (!options_.output_dir.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(options_.output_dir, error);
+    if (error) {
+      std::cerr << "Unable to create " << options_.output_dir << std::endl;
+      return CLI_EXIT_FAILED;
+    }
+  }
+
+  const auto& inputs = options_.inputs;
+  std::vector<char> results(inputs.size(), false);
+  std::atomic<size_t> next = 0;
+  uint32_t jobs = options_.jobs;
+  if (jobs == 0) {
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+  jobs = static_cast<uint32_t>(std::min<size_t>(jobs, inputs.size()));
+  {
+    std::vector<std::jthread> workers;
+    for (uint32_t i = 0; i < jobs; ++i) {
+      workers.emplace_back([&]() {
+        for (size_t index = next++; index < inputs.size(); index = next++) {
+          // Escaping the worker would terminate instead of failing the file
+          try {
+            results[index] = ProcessFile(inputs[index]);
+          } catch (const std::exception& error) {
+            std::cerr << std::format(
+              "{}: {}\n", inputs[index].string(), error.what());
+          }
+        }
+      });
+    }
+  }
+  const bool all_passed = std::ranges::all_of(results, [](char ok) { return ok; });
+  return all_passed ? CLI_EXIT_OK : CLI_EXIT_FAILED;
+}
+
+bool Cli::ParseArguments(const std::vector<std::string>& arguments) {
+  if (arguments.empty()) {
+    return false;
+  }
+  if (arguments[0] == "validate") {
+    options_.command = CliCommand::kValidate;
+  } else if (arguments[0] == "convert") {
+    options_.command = CliCommand::kConvert;
+  } else if (arguments[0] == "export") {
+    options_.command = CliCommand::kExport;
+  } else {
+    std::cerr << "Unknown command: " << arguments[0] << std::endl;
+    return false;
+  }
+
+  bool has_output_format = false;
+  for (size_t i = 1; i < arguments.size(); ++i) {
+    const auto& argument = arguments[i];
+    const bool has_value = i + 1 < arguments.size();
+    if (argument == CLI_STDIO_PATH || !argument.starts_with("-")) {
+      options_.inputs.emplace_back(argument);
+    } else if (!has_value) {
+      std::cerr << "Missing value for " << argument << std::endl;
+      return false;
+    } else if (argument == "--to" || argument == "--from") {
+      auto format = ParseFormat(arguments[++i]);
+      if (!format) {
+        std::cerr << "Unknown format: " << arguments[i] << std::endl;
+        return false;
+      }
+      if (argument == "--to") {
+        options_.output_format = *format;
+        has_output_format = true;
+      } else {
+        options_.input_format = *format;
+      }
+    } else if (argument == "-o" || argument == "--output") {
+      options_.output_dir = arguments[++i];
+    } else if (argument == "-j" || argument == "--jobs") {
+      const auto& value = arguments[++i];
+      auto [end, error] = std::from_chars(
+        value.data(), value.data() + value.size(), options_.jobs);
+      if (error != std::errc() || end != value.data() + value.size()) {
+        std::cerr << "Invalid job count: " << value << std::endl;
+        return false;
+      }
+    } else {
+      std::cerr << "Unknown option: " << argument << std::endl;
+      return false;
+    }
+  }
+
+  if (options_.inputs.empty()) {
+    std::cerr << "No input files" << std::endl;
+    return false;
+  }
+  if (options_.command == CliCommand::kConvert && !has_output_format) {
+    std::cerr << "convert needs --to" << std::endl;
+    return false;
+  }
+  const bool uses_stdio = std::ranges::count(
+    options_.inputs, std::filesystem::path(CLI_STDIO_PATH)) > 0;
+  if (uses_stdio && options_.inputs.size() > 1) {
+    std::cerr << "stdin can not be combined with other inputs" << std::endl;
+    return false;
+  }
+  // .binlo is mapped and renamed into place, a pipe can not do that
+  if (uses_stdio && (options_.input_format == io::DocumentFormat::kBinlo ||
+                      (options_.command == CliCommand::kConvert &&
+                        options_.output_format == io::DocumentFormat::kBinlo))) {
+    std::cerr << "binlo can not be read from stdin or written to stdout"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+std::optional<io::DocumentFormat> Cli::ParseFormat(const std::string& name) {
+  for (auto format : {io::DocumentFormat::kJsonlo, io::DocumentFormat::kBinlo,
+         io::DocumentFormat::kJsonloGz}) {
+    // Accepted with or without the leading dot
+    const std::string extension = io::ExtensionOf(format);
+    if (name == extension || name == extension.substr(1)) {
+      return format;
+    }
+  }
+  return std::nullopt;
+}
+
+void Cli::PrintUsage() {
+  std::cerr <<
+    "Usage: lineaone-cli <command> [options] <files...>\n"
+    "\n"
+    "Commands:\n"
+    "  validate            parse the documents and check their event ids\n"
+    "  convert --to FMT    write each document in another format\n"
+    "  export              write each document as an SVG timeline\n"
+    "\n"
+    "Options:\n"
+    "  -o, --output DIR    output directory, next to the input by default\n"
+    "  -j, --jobs N        worker threads, all cores by default\n"
+    "  --from FMT          format of stdin, jsonlo by default\n"
+    "\n"
+    "FMT is jsonlo, jsonlo.gz or binlo. A single \"-\" input reads stdin and\n"
+    "writes the result to stdout. Exits with 1 when any input is malformed.\n";
+}
+
+bool Cli::ProcessFile(const std::filesystem::path& path) {
+  auto document = doc_man_.OpenDocument(path);
+  if (!document) {
+    std::cerr << std::format("{}: unable to read document\n", path.string());
+    return false;
+  }
+  if (!Validate(*document, path.string())) {
+    return false;
+  }
+  switch (options_.command) {
+    case CliCommand::kValidate:
+      std::cout << std::format(
+        "{}: ok, {} events\n", path.string(), document->events.size());
+      return true;
+    case CliCommand::kConvert: {
+      const auto output = OutputPath(path, io::ExtensionOf(options_.output_format));
+      if (!doc_man_.WriteDocument(*document, output, options_.output_format)) {
+        std::cerr << std::format("{}: unable to write\n", output.string());
+        return false;
+      }
+      return true;
+    }
+    case CliCommand::kExport: {
+      const auto output = OutputPath(path, ".svg");
+      std::ofstream file(output, std::ios::binary | std::ios::trunc);
+      file << export_doc_.ExportTimelineToSVG(document->events, document->state);
+      file.close();
+      if (!file.good()) {
+        std::cerr << std::format("{}: unable to write\n", output.string());
+        return false;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Cli::ProcessStdio() {
+#if defined(_WIN32) || defined(_WIN64)
+  _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  std::optional<Document> document;
+  if (options_.input_format == io::DocumentFormat::kJsonloGz) {
+    if (auto p_buffer = io::GzipStreamBuf::Open(fileno(stdin), std::ios::in)) {
+      std::istream stream(p_buffer.get());
+      document = doc_man_.ReadDocument(stream);
+    }
+  } else {
+    document = doc_man_.ReadDocument(std::cin);
+  }
+  if (!document) {
+    std::cerr << "-: unable to read document" << std::endl;
+    return false;
+  }
+  if (!Validate(*document, CLI_STDIO_PATH)) {
+    return false;
+  }
+
+  bool written = true;
+  switch (options_.command) {
+    case CliCommand::kValidate:
+      std::cerr << std::format("-: ok, {} events\n", document->events.size());
+      break;
+    case CliCommand::kConvert:
+      if (options_.output_format == io::DocumentFormat::kJsonloGz) {
+        std::cout.flush();
+        auto p_buffer = io::GzipStreamBuf::Open(fileno(stdout), std::ios::out);
+        std::ostream stream(p_buffer.get());
+        written = p_buffer && doc_man_.WriteDocument(*document, stream) &&
+                  p_buffer->Close();
+      } else {
+        written = doc_man_.WriteDocument(*document, std::cout);
+      }
+      break;
+    case CliCommand::kExport:
+      std::cout << export_doc_.ExportTimelineToSVG(
+        document->events, document->state);
+      written = std::cout.flush().good();
+      break;
+  }
+  if (!written) {
+    std::cerr << "-: unable to write to stdout" << std::endl;
+  }
+  return written;
+}
+
+bool Cli::Validate(const Document& document, const std::string& name) const {
+  // Journal records and edits address events by id. With duplicates the
+  // store finds the first one, so a later one is found elsewhere
+  const auto ids = document.events.ids();
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (document.events.find(ids[i]).Index() != i) {
+      std::cerr << std::format("{}: duplicate event id {}\n", name, ids[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+std::filesystem::path Cli::OutputPath(
+  const std::filesystem::path& input, const char* extension) const {
+  // .jsonlo.gz has two extensions to strip
+  auto stem = io::IsJsonloGzPath(input) ? input.stem().stem() : input.stem();
+  const auto directory =
+    options_.output_dir.empty() ? input.parent_path() : options_.output_dir;
+  return directory / (stem += extension);
+}
+
+}  // namespace linea_one
@@ -0,0 +1,140 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: date_sort.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <date_sort.h>
+#include <parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <utility>
+
+namespace linea_one {
+
+namespace {
+
+constexpr std::size_t kBuckets = std::size_t{1} << DATE_SORT_DIGIT_BITS;
+
+struct KeyedPosition {
+  uint64_t key;
+  uint32_t position;
+};
+
+/* Least significant digit first, each pass is stable. False when stopped. */
+template <typename Item, typename KeyOf>
+bool RadixSort(std::vector<Item>& items, KeyOf const key_of, int const bits,
+  const std::stop_token& stop, const std::function<void(float)>& progress) {
+  const std::size_t parts = ParallelParts(items.size());
+  const std::size_t part_size = (items.size() + parts - 1) / parts;
+  const auto part_range = [&](std::size_t const part) {
+    const auto begin = std::min(part * part_size, items.size());
+    return std::pair{begin, std::min(begin + part_size, items.size())};
+  };
+  std::vector<Item> buffer(items.size());
+  std::vector<std::array<std::size_t, kBuckets>> counts(parts);
+  const int passes = (bits + DATE_SORT_DIGIT_BITS - 1) / DATE_SORT_DIGIT_BITS;
+  for (int pass = 0; pass < passes; ++pass) {
+    if (stop.stop_requested()) {
+      return false;
+    }
+    const int shift = pass * DATE_SORT_DIGIT_BITS;
+    const auto digit = [&](const Item& item) {
+      return static_cast<std::size_t>(key_of(item) >> shift) & (kBuckets - 1);
+    };
+    ParallelFor(parts, [&](std::size_t const part) {
+      auto& count = counts[part];
+      count.fill(0);
+      const auto [begin, end] = part_range(part);
+      for (auto i = begin; i < end; ++i) {
+        ++count[digit(items[i])];
+      }
+    });
+    // Turn the counts into where each part writes each digit
+    std::size_t offset = 0;
+    bool shared = false;
+    for (std::size_t bucket = 0; bucket < kBuckets && !shared; ++bucket) {
+      const std::size_t start = offset;
+      for (auto& count : counts) {
+        offset += std::exchange(count[bucket], offset);
+      }
+      shared = offset - start == items.size();
+    }
+    if (!shared) {
+      ParallelFor(parts, [&](std::size_t const part) {
+        auto& next = counts[part];
+        const auto [begin, end] = part_range(part);
+        for (auto i = begin; i < end; ++i) {
+          buffer[next[digit(items[i])]++] = items[i];
+        }
+      });
+      items.swap(buffer);
+    }
+    if (progress) {
+      progress(static_cast<float>(pass + 1) / static_cast<float>(passes));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<std::vector<uint64_t>> SortDates(std::span<const EventDate> dates,
+  const std::stop_token& stop, const std::function<void(float)>& progress) {
+  std::vector<uint64_t> order(dates.size());
+  if (dates.empty()) {
+    return order;
+  }
+  const auto [min, max] = std::ranges::minmax(dates);
+  const auto relative = [base = min.Key()](EventDate const date) {
+    return static_cast<uint64_t>(date.Key()) - static_cast<uint64_t>(base);
+  };
+  const int key_bits = std::bit_width(relative(max));
+  const int position_bits = std::bit_width(dates.size() - 1);
+  if (key_bits + position_bits <= 64) {
+    for (std::size_t i = 0; i < dates.size(); ++i) {
+      order[i] = relative(dates[i]) << position_bits | i;
+    }
+    if (!RadixSort(
+          order, [position_bits](uint64_t const item) {
+            return item >> position_bits;
+          }, key_bits, stop, progress)) {
+      return std::nullopt;
+    }
+    const uint64_t mask = (uint64_t{1} << position_bits) - 1;
+    for (auto& item : order) {
+      item &= mask;
+    }
+    return order;
+  }
+  // Dates too far apart to share a word with the position
+  std::vector<KeyedPosition> keyed(dates.size());
+  for (std::size_t i = 0; i < dates.size(); ++i) {
+    keyed[i] = {relative(dates[i]), static_cast<uint32_t>(i)};
+  }
+  if (!RadixSort(
+        keyed, [](const KeyedPosition& item) { return item.key; }, key_bits,
+        stop, progress)) {
+    return std::nullopt;
+  }
+  std::ranges::transform(keyed, order.begin(), &KeyedPosition::position);
+  return order;
+}
+
+}  // namespace linea_one
@@ -0,0 +1,64 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: document_changes.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <document_changes.h>
+
+#include <algorithm>
+
+namespace linea_one {
+
+void DocumentChanges::MarkEvent(const uint64_t id) {
+  changed_[id] = ++revision_;
+  deleted_.erase(id);
+}
+
+void DocumentChanges::MarkDeleted(const uint64_t id) {
+  deleted_[id] = ++revision_;
+  changed_.erase(id);
+}
+
+void DocumentChanges::MarkOrder() { order_revision_ = ++revision_; }
+
+uint64_t DocumentChanges::Revision() const { return revision_; }
+
+DocumentDelta DocumentChanges::Since(const uint64_t revision) const {
+  DocumentDelta delta;
+  for (const auto& [id, changed_at] : changed_) {
+    if (changed_at > revision) {
+      delta.changed.push_back(id);
+    }
+  }
+  for (const auto& [id, deleted_at] : deleted_) {
+    if (deleted_at > revision) {
+      delta.deleted.push_back(id);
+    }
+  }
+  delta.order_changed = order_revision_ > revision;
+  return delta;
+}
+
+void DocumentChanges::Forget(const uint64_t revision) {
+  std::erase_if(
+    changed_, [revision](const auto& entry) { return entry.second <= revision; });
+  std::erase_if(
+    deleted_, [revision](const auto& entry) { return entry.second <= revision; });
+}
+
+}  // namespace linea_one
@@ -0,0 +1,332 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: document_history.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <document_history.h>
+
+#include <algorithm>
+
+namespace linea_one {
+
+namespace {
+
+template <typename T>
+std::size_t HeapBytes(const T&) {
+  return 0;
+}
+std::size_t HeapBytes(const InsertEdit& edit) {
+  return edit.event.headline.capacity() + edit.event.description.capacity();
+}
+std::size_t HeapBytes(const DeleteEdit& edit) {
+  return edit.event.headline.capacity() + edit.event.description.capacity();
+}
+std::size_t HeapBytes(const TextEdit& edit) {
+  return edit.removed.capacity() + edit.inserted.capacity();
+}
+std::size_t HeapBytes(const OrderEdit& edit) {
+  return edit.order.capacity() * sizeof(uint64_t);
+}
+
+std::size_t BytesOf(const Edit& edit) {
+  return sizeof(Edit) +
+         std::visit([](const auto& any) { return HeapBytes(any); }, edit);
+}
+
+bool Put(EventStore& events, DocumentChanges& changes, uint64_t const position,
+  const TimelineEvent& event) {
+  if (position > events.size() || events.contains(event.id)) {
+    return false;
+  }
+  events.insert(position, event);
+  changes.MarkEvent(event.id);
+  if (position + 1 != events.size()) {
+    changes.MarkOrder();
+  }
+  return true;
+}
+
+bool Take(EventStore& events, DocumentChanges& changes, uint64_t const position,
+  uint64_t const id) {
+  if (position >= events.size() || events.ids()[position] != id) {
+    return false;
+  }
+  events.erase(position);
+  changes.MarkDeleted(id);
+  return true;
+}
+
+bool Apply(const InsertEdit& edit, bool const undo, EventStore& events,
+  DocumentChanges& changes) {
+  return undo ? Take(events, changes, edit.position, edit.event.id)
+              : Put(events, changes, edit.position, edit.event);
+}
+
+bool Apply(const DeleteEdit& edit, bool const undo, EventStore& events,
+  DocumentChanges& changes) {
+  return undo ? Put(events, changes, edit.position, edit.event)
+              : Take(events, changes, edit.position, edit.event.id);
+}
+
+bool Apply(const DateEdit& edit, bool const undo, EventStore& events,
+  DocumentChanges& changes) {
+  auto found = events.find(edit.id);
+  if (found == events.end()) {
+    return false;
+  }
+  const bool moved = edit.from != edit.to;
+  if (moved && found.Index() != (undo ? edit.to : edit.from)) {
+    return false;
+  }
+  (*found).date = undo ? edit.before : edit.after;
+  changes.MarkEvent(edit.id);
+  if (moved) {
+    undo ? events.move(edit.to, edit.from) : events.move(edit.from, edit.to);
+    changes.MarkOrder();
+  }
+  return true;
+}
+
+bool Apply(const ExpandedEdit& edit, bool, EventStore& events,
+  DocumentChanges& changes) {
+  auto found = events.find(edit.id);
+  if (found == events.end()) {
+    return false;
+  }
+  auto event = *found;
+  event.expanded = !event.expanded;
+  changes.MarkEvent(edit.id);
+  return true;
+}
+
+bool Apply(const TextEdit& edit, bool const undo, EventStore& events,
+  DocumentChanges& changes) {
+  auto found = events.find(edit.id);
+  if (found == events.end()) {
+    return false;
+  }
+  auto event = *found;
+  auto target =
+    edit.field == TextField::kHeadline ? event.headline : event.description;
+  const auto& present = undo ? edit.inserted : edit.removed;
+  const auto& wanted = undo ? edit.removed : edit.inserted;
+  std::string text(target.str());
+  if (edit.offset + present.size() > text.size()) {
+    return false;
+  }
+  text.replace(edit.offset, present.size(), wanted);
+  target = text;
+  changes.MarkEvent(edit.id);
+  return true;
+}
+
+bool Apply(const SwapEdit& edit, bool, EventStore& events,
+  DocumentChanges& changes) {
+  if (edit.a >= events.size() || edit.b >= events.size()) {
+    return false;
+  }
+  events.swap(edit.a, edit.b);
+  changes.MarkOrder();
+  return true;
+}
+
+bool Apply(const OrderEdit& edit, bool const undo, EventStore& events,
+  DocumentChanges& changes) {
+  if (edit.order.size() != events.size()) {
+    return false;
+  }
+  if (!undo) {
+    events.reorder(edit.order);
+  } else {
+    std::vector<uint64_t> inverse(edit.order.size());
+    for (uint64_t i = 0; i < edit.order.size(); ++i) {
+      inverse[edit.order[i]] = i;
+    }
+    events.reorder(inverse);
+  }
+  changes.MarkOrder();
+  return true;
+}
+
+}  // namespace
+
+void DocumentHistory::RecordInsert(
+  uint64_t const position, TimelineEvent event) {
+  Push(InsertEdit{position, std::move(event)});
+}
+
+void DocumentHistory::RecordDelete(
+  uint64_t const position, TimelineEvent event) {
+  Push(DeleteEdit{position, std::move(event)});
+}
+
+void DocumentHistory::RecordDate(
+  uint64_t const id, EventDate const before, EventDate const after) {
+  if (!sealed_ && !undo_.empty()) {
+    if (auto* p_last = std::get_if<DateEdit>(&undo_.back());
+        p_last && p_last->id == id) {
+      p_last->after = after;
+      return;
+    }
+  }
+  Push(DateEdit{id, before, after});
+  sealed_ = false;
+}
+
+void DocumentHistory::RecordMove(uint64_t const id, EventDate const date,
+  uint64_t const from, uint64_t const to) {
+  if (!undo_.empty()) {
+    if (auto* p_last = std::get_if<DateEdit>(&undo_.back());
+        p_last && p_last->id == id && p_last->after == date) {
+      // A drag moves the event every frame, the step keeps where it began
+      if (p_last->from == p_last->to) {
+        p_last->from = from;
+      }
+      p_last->to = to;
+      return;
+    }
+  }
+  Push(DateEdit{id, date, date, from, to});
+}
+
+void DocumentHistory::RecordExpanded(uint64_t const id) {
+  Push(ExpandedEdit{id});
+}
+
+void DocumentHistory::RecordText(uint64_t const id, TextField const field,
+  std::string_view before, std::string_view const after) {
+  // A keystroke extending the last step diffs against the text before it
+  std::string original;
+  if (!sealed_ && !undo_.empty()) {
+    if (auto* p_last = std::get_if<TextEdit>(&undo_.back());
+        p_last && p_last->id == id && p_last->field == field &&
+        p_last->offset + p_last->inserted.size() <= before.size()) {
+      original = before;
+      original.replace(p_last->offset, p_last->inserted.size(), p_last->removed);
+      before = original;
+      bytes_ -= BytesOf(undo_.back());
+      undo_.pop_back();
+    }
+  }
+
+  const auto prefix = static_cast<uint64_t>(
+    std::ranges::mismatch(before, after).in1 - before.begin());
+  uint64_t suffix = 0;
+  while (suffix < before.size() - prefix && suffix < after.size() - prefix &&
+         before[before.size() - 1 - suffix] == after[after.size() - 1 - suffix]) {
+    ++suffix;
+  }
+  TextEdit edit{id, field, prefix,
+    std::string(before.substr(prefix, before.size() - prefix - suffix)),
+    std::string(after.substr(prefix, after.size() - prefix - suffix))};
+  if (edit.removed.empty() && edit.inserted.empty()) {
+    Trim();
+    return;
+  }
+  Push(std::move(edit));
+  sealed_ = false;
+}
+
+void DocumentHistory::RecordSwap(uint64_t const a, uint64_t const b) {
+  Push(SwapEdit{a, b});
+}
+
+void DocumentHistory::RecordOrder(std::vector<uint64_t> order) {
+  Push(OrderEdit{std::move(order)});
+}
+
+void DocumentHistory::Seal() { sealed_ = true; }
+
+bool DocumentHistory::Undo(EventStore& events, DocumentChanges& changes) {
+  sealed_ = true;
+  if (undo_.empty()) {
+    return false;
+  }
+  auto edit = std::move(undo_.back());
+  undo_.pop_back();
+  const bool applied = std::visit(
+    [&](const auto& any) { return Apply(any, true, events, changes); }, edit);
+  if (!applied) {
+    // The events no longer match the log, nothing older can be trusted
+    Clear();
+    return false;
+  }
+  redo_.push_back(std::move(edit));
+  return true;
+}
+
+bool DocumentHistory::Redo(EventStore& events, DocumentChanges& changes) {
+  sealed_ = true;
+  if (redo_.empty()) {
+    return false;
+  }
+  auto edit = std::move(redo_.back());
+  redo_.pop_back();
+  const bool applied = std::visit(
+    [&](const auto& any) { return Apply(any, false, events, changes); }, edit);
+  if (!applied) {
+    Clear();
+    return false;
+  }
+  undo_.push_back(std::move(edit));
+  return true;
+}
+
+bool DocumentHistory::CanUndo() const { return !undo_.empty(); }
+
+bool DocumentHistory::CanRedo() const { return !redo_.empty(); }
+
+void DocumentHistory::SetBudget(std::size_t const bytes) {
+  budget_ = bytes;
+  Trim();
+}
+
+std::size_t DocumentHistory::Bytes() const { return bytes_; }
+
+void DocumentHistory::Clear() {
+  undo_.clear();
+  redo_.clear();
+  bytes_ = 0;
+  sealed_ = true;
+}
+
+void DocumentHistory::Push(Edit edit) {
+  for (const auto& undone : redo_) {
+    bytes_ -= BytesOf(undone);
+  }
+  redo_.clear();
+  bytes_ += BytesOf(edit);
+  undo_.push_back(std::move(edit));
+  sealed_ = true;
+  Trim();
+}
+
+void DocumentHistory::Trim() {
+  // Oldest first, later steps never depend on them
+  while (bytes_ > budget_ && !undo_.empty()) {
+    bytes_ -= BytesOf(undo_.front());
+    undo_.pop_front();
+  }
+  // Everything undone, the redo furthest from now goes first
+  while (bytes_ > budget_ && !redo_.empty()) {
+    bytes_ -= BytesOf(redo_.front());
+    redo_.pop_front();
+  }
+}
+
+}  // namespace linea_one
@@ -18,176 +18,657 @@
  * File: document_manager.cpp
  * Created by kureii on 8/11/24
  */
-#include <config.h>
 #include <document_manager.h>
+#include <io/io_binlo_codec.h>
+#include <io/io_document_format.h>
+#include <io/io_file_sync.h>
+#include <io/io_gzip_stream.h>
+#include <io/io_jsonlo_reader.h>
+#include <io/io_jsonlo_writer.h>
 
 #include <algorithm>
+#include <chrono>
 #include <format>
 #include <fstream>
+#include <iostream>
+#include <limits>
+#include <tuple>
 
 namespace linea_one {
 
+namespace {
+
+struct LoadBatch {
+  explicit LoadBatch(std::vector<std::filesystem::path> batch_paths)
+    : paths(std::move(batch_paths)), results(paths.size()) {}
+
+  std::vector<std::filesystem::path> paths;
+  std::vector<std::promise<std::optional<Document>>> results;
+  std::atomic<size_t> next = 0;
+};
+
+/* What a background job reads. The events are shared with the document
+ * until either side writes, the undo history and change log stay behind. */
+std::shared_ptr<const Document> Snapshot(const Document& document) {
+  return std::make_shared<const Document>(Document{.name = document.name,
+    .saved = document.saved,
+    .state = document.state,
+    .events = document.events,
+    .path = document.path});
+}
+
+}  // namespace
+
 DocumentManager::DocumentManager() {
-  documents_ = std::vector<Document>();
+  p_journal_ = std::make_shared<io::Journal>();
 }
 
-void DocumentManager::CreateNewDocument() {
+DocumentManager::~DocumentManager() {
+  write_queue_.Wait();
+  for (auto& pending : pending_saves_) {
+    FinishSave(pending, pending.result.get());
+  }
+  // Unsaved documents keep their recovery for the next start
+  for (const auto handle : tab_order_) {
+    if (auto* p_document = documents_.Get(handle); p_document->saved) {
+      DropRecovery(*p_document);
+    }
+  }
+}
+
+DocumentHandle DocumentManager::CreateNewDocument() {
   new_doc_counter++;
-  Document new_doc = {std::format("New Document {}", new_doc_counter), false};
+  // Built in its slot, nothing is moved afterwards
+  current_document_ = documents_.Emplace(
+    std::format("New Document {}", new_doc_counter), false);
+  tab_order_.push_back(current_document_);
+  auto& new_doc = *documents_.Get(current_document_);
   new_doc.state.zoom = 1.0f;
   new_doc.state.offset = 0.0f;
-  new_doc.state.minYear = std::numeric_limits<int>::max();
-  new_doc.state.maxYear = std::numeric_limits<int>::min();
-
-  for (const auto& event : new_doc.events) {
-    new_doc.state.minYear = std::min(new_doc.state.minYear, event.year);
-    new_doc.state.maxYear = std::max(new_doc.state.maxYear, event.year);
-  }
+  std::tie(new_doc.state.minYear, new_doc.state.maxYear) =
+    new_doc.events.year_range();
 
   // Ensure we have a valid range even if there are no events
   if (new_doc.state.minYear == std::numeric_limits<int>::max()) {
     new_doc.state.minYear = 2000;
     new_doc.state.maxYear = 2000;
   }
-
-  documents_.push_back(new_doc);
-  current_document_ = static_cast<int32_t>(documents_.size() - 1);
+  return current_document_;
 }
 
 Document* DocumentManager::GetCurrentDocument() {
-  if (current_document_ >= 0 && current_document_ < documents_.size())
-    return &documents_[current_document_];
-  return nullptr;
+  return documents_.Get(current_document_);
 }
 
 void DocumentManager::CloseDocument() {
-  if (doc_to_close_ >= 0) {
-    documents_.erase(documents_.begin() + doc_to_close_);
-    if (current_document_ >= documents_.size()) {
-      current_document_ =
-        static_cast<int>(documents_.empty() ? -1 : documents_.size() - 1);
-    }
+  auto* p_document = documents_.Get(doc_to_close_);
+  if (!p_document) {
+    return;
   }
+  DropRecovery(*p_document);
+  documents_.Erase(doc_to_close_);
+  const auto tab = std::ranges::find(tab_order_, doc_to_close_);
+  const auto position = tab - tab_order_.begin();
+  tab_order_.erase(tab);
+  if (current_document_ == doc_to_close_) {
+    // The tab that moves into the closed one's place becomes current
+    current_document_ =
+      tab_order_.empty()
+        ? DocumentHandle{}
+        : tab_order_[std::min<size_t>(position, tab_order_.size() - 1)];
+  }
+  doc_to_close_ = {};
 }
 
-int32_t DocumentManager::CloseDocumentWithCheck(int32_t const index) {
-  if (index >= 0 && index < documents_.size()) {
-    doc_to_close_ = index;
-    if (!documents_[index].saved) {
-      return index;
-    } else {
-      CloseDocument();
-      return -1;
-    }
+CloseResult DocumentManager::CloseDocumentWithCheck(
+  DocumentHandle const handle) {
+  const auto* p_document = documents_.Get(handle);
+  if (!p_document) {
+    return CloseResult::kMissing;
   }
-  return -2;
+  doc_to_close_ = handle;
+  if (!p_document->saved) {
+    return CloseResult::kUnsaved;
+  }
+  CloseDocument();
+  return CloseResult::kClosed;
 }
 
-int32_t DocumentManager::DocumentSize() const {
-  return static_cast<int32_t>(documents_.size());
+Document* DocumentManager::GetDocument(DocumentHandle const handle) {
+  return documents_.Get(handle);
 }
 
-Document& DocumentManager::GetSpecificDocument(int32_t const index) {
-  return documents_[index];
+const std::vector<DocumentHandle>& DocumentManager::GetDocuments() const {
+  return tab_order_;
 }
 
-int32_t DocumentManager::GetCurrentDocumentIndex() const {
+DocumentHandle DocumentManager::GetCurrentDocumentHandle() const {
   return current_document_;
 }
 
-int32_t DocumentManager::GetDocToClose() const { return doc_to_close_; }
+DocumentHandle DocumentManager::GetDocToClose() const { return doc_to_close_; }
+
+void DocumentManager::SetCurrentDocument(DocumentHandle const handle) {
+  current_document_ = handle;
+}
+
+void DocumentManager::SetDocToClose(DocumentHandle const handle) {
+  doc_to_close_ = handle;
+}
+
+bool DocumentManager::Undo() {
+  auto* p_document = GetCurrentDocument();
+  if (!p_document ||
+      !p_document->history.Undo(p_document->events, p_document->changes)) {
+    return false;
+  }
+  p_document->saved = false;
+  return true;
+}
 
-void DocumentManager::SetCurrentDocumentIndex(int32_t const index) {
-  current_document_ = index;
+bool DocumentManager::Redo() {
+  auto* p_document = GetCurrentDocument();
+  if (!p_document ||
+      !p_document->history.Redo(p_document->events, p_document->changes)) {
+    return false;
+  }
+  p_document->saved = false;
+  return true;
 }
 
-void DocumentManager::SetDocToClose(int32_t const index) {
-  doc_to_close_ = index;
+bool DocumentManager::CanUndo() {
+  const auto* p_document = GetCurrentDocument();
+  return p_document && p_document->history.CanUndo();
+}
+
+bool DocumentManager::CanRedo() {
+  const auto* p_document = GetCurrentDocument();
+  return p_document && p_document->history.CanRedo();
+}
+
+void DocumentManager::SaveDocument() { SaveDocument(current_document_); }
+
+void DocumentManager::SaveDocument(DocumentHandle const handle) {
+  auto* p_document = documents_.Get(handle);
+  if (!p_document || p_document->saved || p_document->path.empty()) {
+    return;
+  }
+  auto& document = *p_document;
+  const uint64_t revision = document.changes.Revision();
+  if (std::ranges::any_of(pending_saves_, [&](const PendingSave& pending) {
+        return pending.document == handle &&
+               pending.revision == revision && pending.path == document.path;
+      })) {
+    return;
+  }
+
+  // Texts replaced while editing are dropped before they would be copied
+  document.events.compact_text();
+  // The writer gets its own copy, so editing can go on during the write
+  auto p_snapshot = Snapshot(document);
+  const bool append = journal_mode_ && document.synced_path == document.path;
+  auto p_result = std::make_shared<std::promise<SaveResult>>();
+  pending_saves_.push_back(
+    {handle, revision, document.path, p_result->get_future()});
+  // The job owns the only snapshot reference, it is freed on the writer thread
+  write_queue_.Push([this, p_snapshot, p_result, append,
+                      journal_mode = journal_mode_,
+                      delta = document.changes.Since(document.saved_revision)]() {
+    p_result->set_value(WriteSnapshot(*p_snapshot, delta, append, journal_mode));
+  });
 }
 
-void DocumentManager::SetDocOnIndex(Document& document, int64_t const index) {
-  if (index >= 0 && index < documents_.size()) {
-    documents_[index] = document;
+void DocumentManager::Update() {
+  std::erase_if(pending_saves_, [this](PendingSave& pending) {
+    if (pending.result.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return false;
+    }
+    FinishSave(pending, pending.result.get());
+    return true;
+  });
+  std::erase_if(pending_loads_, [this](PendingLoad& pending) {
+    if (pending.result.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return false;
+    }
+    AddDocument(pending.path, pending.result.get());
+    return true;
+  });
+  if (pending_loads_.empty()) {
+    // Every file was handed out, the workers are on their way out
+    load_threads_.clear();
+  }
+  std::vector<DocumentHandle> resort;
+  std::erase_if(pending_sorts_, [this, &resort](PendingSort& pending) {
+    if (pending.result.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return false;
+    }
+    if (pending.worker.get_stop_token().stop_requested()) {
+      return true;
+    }
+    if (!FinishSort(pending, pending.result.get())) {
+      resort.push_back(pending.document);
+    }
+    return true;
+  });
+  for (const auto handle : resort) {
+    SortDocument(handle);
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (autosave_interval_.count() > 0 &&
+      now - last_autosave_ >= autosave_interval_) {
+    last_autosave_ = now;
+    Autosave();
   }
 }
 
-void DocumentManager::SaveDocument() {
-  if (current_document_ < 0 || documents_[current_document_].saved || documents_[current_document_].path.empty()) {
+bool DocumentManager::IsSaving(DocumentHandle const handle) const {
+  return documents_.Contains(handle) &&
+         std::ranges::any_of(pending_saves_, [&](const PendingSave& pending) {
+           return pending.document == handle;
+         });
+}
+
+void DocumentManager::SortDocument(DocumentHandle const handle) {
+  auto* p_document = documents_.Get(handle);
+  if (!p_document || IsSorting(handle)) {
     return;
   }
-  std::ofstream file( documents_[current_document_].path, std::ios::binary);
-  if (file.is_open()) {
-    std::string serializedData = SerializeDocument(documents_[current_document_]);
-    file.write(serializedData.c_str(), serializedData.size());
-    file.close();
+  auto& document = *p_document;
+  std::promise<SortResult> promise;
+  PendingSort pending{handle, document.changes.Revision(),
+    std::make_shared<std::atomic<float>>(0.0f), promise.get_future()};
+  // A copy of the store is a snapshot, the worker's writes clone the columns
+  // on its own thread and leave the document alone
+  pending.worker = std::jthread(
+    [events = document.events, promise = std::move(promise),
+      p_progress = pending.p_progress](std::stop_token stop) mutable {
+      SortResult result{std::move(events), {}};
+      // Cancelled, the result is dropped unseen
+      result.order = result.events
+                       .sort_by_date(stop,
+                         [&p_progress](float const done) {
+                           p_progress->store(done, std::memory_order_relaxed);
+                         })
+                       .value_or(std::vector<uint64_t>{});
+      promise.set_value(std::move(result));
+    });
+  pending_sorts_.push_back(std::move(pending));
+}
 
-    if (file.good()) {
-      documents_[current_document_].saved = true;
+bool DocumentManager::IsSorting(DocumentHandle const handle) const {
+  return documents_.Contains(handle) &&
+         std::ranges::any_of(pending_sorts_, [&](const PendingSort& pending) {
+           return pending.document == handle;
+         });
+}
+
+std::optional<float> DocumentManager::GetSortProgress(
+  DocumentHandle const handle) const {
+  if (!documents_.Contains(handle)) {
+    return std::nullopt;
+  }
+  const auto pending = std::ranges::find(
+    pending_sorts_, handle, &PendingSort::document);
+  if (pending == pending_sorts_.end()) {
+    return std::nullopt;
+  }
+  return pending->p_progress->load(std::memory_order_relaxed);
+}
+
+void DocumentManager::CancelSort(DocumentHandle const handle) {
+  for (auto& pending : pending_sorts_) {
+    if (pending.document == handle) {
+      pending.worker.request_stop();
     }
   }
 }
 
-void DocumentManager::LoadDocument(std::filesystem::path path) {
-  std::ifstream file(path, std::ios::binary);
-  if (file.is_open()) {
-    auto doc = DeserializeDocument(file);
-    doc.path = path;
-    documents_.emplace_back(doc);
-    file.close();
-  }
-}
-
-std::string DocumentManager::SerializeDocument(Document& document) {
-  auto json_string = std::format(R"({{
-  "Name": "{}",
-  "Version": "{}.{}",
-  "State": {{
-    "Zoom": {},
-    "Offset": {}
-  }},
-  "Events": [
-)",
-    document.name, PROJECT_VERSION_MAJOR, PROJECT_VERSION_MINOR,
-    document.state.zoom, document.state.offset);
-
-  for (uint64_t i = 0; i < document.events.size(); i++) {
-    json_string += std::format(R"(    {{
-      "Id": {},
-      "Year": {},
-      "Headline": "{}",
-      "Description": "{}",
-      "Expanded": {}
-    }})",document.events[i].id, document.events[i].year,
-    document.events[i].headline, document.events[i].description,
-    document.events[i].expanded);
-    if (i+1 != document.events.size()) {
-      json_string += ",\n";
-    } else {
-      json_string += "\n";
+bool DocumentManager::FinishSort(PendingSort& pending, SortResult result) {
+  // Closed while sorting, the handle no longer resolves
+  auto* document = documents_.Get(pending.document);
+  if (!document) {
+    return true;
+  }
+  if (document->changes.Revision() != pending.revision) {
+    return false;
+  }
+  if (result.order.empty()) {
+    return true;
+  }
+  document->events = std::move(result.events);
+  document->history.RecordOrder(std::move(result.order));
+  document->changes.MarkOrder();
+  document->saved = false;
+  return true;
+}
+
+SaveResult DocumentManager::WriteSnapshot(const Document& snapshot,
+  const DocumentDelta& delta, bool const append, bool const journal_mode) {
+  const auto& path = snapshot.path;
+  if (append && p_journal_->Append(snapshot, delta, path)) {
+    std::error_code error;
+    const auto base_size = std::filesystem::file_size(path, error);
+    if (!error && p_journal_->Size(path) >
+                    std::max<uint64_t>(JOURNAL_COMPACT_MIN_BYTES, base_size / 2)) {
+      StartCompaction(path);
     }
+    return SaveResult::kJournaled;
+  }
+
+  auto lock = p_journal_->Lock();
+  if (!WriteDocument(snapshot, path, io::FormatFromPath(path))) {
+    return SaveResult::kFailed;
   }
-  json_string += "  ]\n}\n";
-  return json_string;
-}
-
-Document DocumentManager::DeserializeDocument(
-  std::ifstream &json_file) {
-    nlohmann::json json_data = nlohmann::json::parse(json_file);
-  Document document;
-  document.name = json_data["Name"];
-  document.saved = true;
-  document.state.offset = json_data["State"]["Offset"];
-  document.state.zoom = json_data["State"]["Zoom"];
-  for (uint64_t i = 0; i < json_data["Events"].size(); i++) {
-    TimelineEvent event;
-    event.id = json_data["Events"][i]["Id"];
-    event.year = json_data["Events"][i]["Year"];
-    event.headline = json_data["Events"][i]["Headline"];
-    event.description = json_data["Events"][i]["Description"];
-    event.expanded = json_data["Events"][i]["Expanded"];
-    document.events.emplace_back(event);
+  if (journal_mode) {
+    p_journal_->Reset(path);
+  } else {
+    p_journal_->Remove(path);
   }
+  return SaveResult::kWritten;
+}
+
+void DocumentManager::FinishSave(PendingSave& pending, SaveResult const result) {
+  if (result == SaveResult::kFailed) {
+    std::cerr << "Unable to save document: " << pending.path << std::endl;
+    return;
+  }
+  auto* document = documents_.Get(pending.document);
+  if (!document) {
+    return;
+  }
+  if (result == SaveResult::kWritten) {
+    document->synced_path = pending.path;
+  }
+  if (pending.revision > document->saved_revision) {
+    document->saved_revision = pending.revision;
+    document->changes.Forget(pending.revision);
+  }
+  // Edits made while writing keep the tab unsaved
+  if (document->path == pending.path &&
+      document->changes.Revision() == pending.revision) {
+    document->saved = true;
+  }
+}
+
+DocumentHandle DocumentManager::LoadDocument(std::filesystem::path path) {
+  return AddDocument(path, OpenDocument(path));
+}
+
+void DocumentManager::LoadDocuments(
+  const std::vector<std::filesystem::path>& paths) {
+  if (paths.empty()) {
+    return;
+  }
+  auto p_batch = std::make_shared<LoadBatch>(paths);
+  for (size_t i = 0; i < paths.size(); ++i) {
+    pending_loads_.push_back({paths[i], p_batch->results[i].get_future()});
+  }
+  // Files are handed out one at a time, so a big one does not hold up others
+  const size_t workers = std::min<size_t>(
+    paths.size(), std::max(1u, std::thread::hardware_concurrency()));
+  for (size_t i = 0; i < workers; ++i) {
+    load_threads_.emplace_back([this, p_batch](std::stop_token stop) {
+      for (size_t next = p_batch->next++;
+           next < p_batch->paths.size() && !stop.stop_requested();
+           next = p_batch->next++) {
+        p_batch->results[next].set_value(OpenDocument(p_batch->paths[next]));
+      }
+    });
+  }
+}
+
+bool DocumentManager::IsLoading() const { return !pending_loads_.empty(); }
+
+void DocumentManager::SetJournalMode(bool const journal_mode) {
+  journal_mode_ = journal_mode;
+}
+
+bool DocumentManager::GetJournalMode() const { return journal_mode_; }
+
+void DocumentManager::SetAutosaveInterval(std::chrono::seconds const interval) {
+  autosave_interval_ = interval;
+}
+
+std::chrono::seconds DocumentManager::GetAutosaveInterval() const {
+  return autosave_interval_;
+}
+
+std::vector<io::RecoveredDocument> DocumentManager::FindRecoveries() const {
+  return io::Recovery::List();
+}
+
+void DocumentManager::RestoreDocuments(
+  const std::vector<io::RecoveredDocument>& recoveries) {
+  for (const auto& recovery : recoveries) {
+    auto document = recovery.source_path.empty()
+                      ? std::optional<Document>(Document{})
+                      : OpenDocument(recovery.source_path);
+    if (!document ||
+        !io::Recovery::Restore(*document, recovery.recovery_path)) {
+      std::cerr << "Unable to restore document: " << recovery.recovery_path
+                << std::endl;
+      continue;
+    }
+    document->name = recovery.name;
+    document->path = recovery.source_path;
+    document->saved = false;
+    // The file on disk lacks the recovered edits, the next save rewrites it
+    document->synced_path.clear();
+    document->recovery_path = recovery.recovery_path;
+    tab_order_.push_back(documents_.Emplace(std::move(*document)));
+  }
+}
+
+void DocumentManager::DiscardRecoveries(
+  const std::vector<io::RecoveredDocument>& recoveries) {
+  for (const auto& recovery : recoveries) {
+    io::Recovery::Remove(recovery.recovery_path);
+  }
+}
+
+void DocumentManager::Autosave() {
+  for (const auto handle : tab_order_) {
+    auto& document = *documents_.Get(handle);
+    // A landed save may have forgotten changes the recovery still needs
+    if (document.saved || document.recovery_revision < document.saved_revision) {
+      DropRecovery(document);
+    }
+    if (document.saved) {
+      continue;
+    }
+    const uint64_t revision = document.changes.Revision();
+    if (document.recovery_path.empty()) {
+      StartRecovery(document);
+    } else if (revision != document.recovery_revision) {
+      // Only the edits since the previous snapshot are encoded, off this
+      // thread, from a snapshot that shares the events
+      recovery_queue_.Push([recovery_path = document.recovery_path,
+                             p_snapshot = Snapshot(document),
+                             delta = document.changes.Since(
+                               document.recovery_revision)]() {
+        io::Recovery::Append(
+          recovery_path, io::Journal::EncodeFrame(*p_snapshot, delta));
+      });
+    }
+    document.recovery_revision = revision;
+  }
+}
+
+void DocumentManager::StartRecovery(Document& document) {
+  document.recovery_path = io::Recovery::NewPath();
+  if (!document.path.empty() && document.synced_path == document.path) {
+    // The saved file is the starting point, only newer edits are recorded
+    recovery_queue_.Push([recovery_path = document.recovery_path,
+                           p_snapshot = Snapshot(document),
+                           delta = document.changes.Since(
+                             document.saved_revision)]() {
+      io::Recovery::Start(recovery_path, p_snapshot->path, p_snapshot->name) &&
+        io::Recovery::Append(
+          recovery_path, io::Journal::EncodeFrame(*p_snapshot, delta));
+    });
+    return;
+  }
+  // Nothing on disk to build on, the first frame carries every event
+  auto p_snapshot = Snapshot(document);
+  recovery_queue_.Push(
+    [recovery_path = document.recovery_path, p_snapshot]() {
+      DocumentDelta everything;
+      everything.order_changed = true;
+      everything.changed.reserve(p_snapshot->events.size());
+      for (const auto& event : p_snapshot->events) {
+        everything.changed.push_back(event.id);
+      }
+      io::Recovery::Start(recovery_path, {}, p_snapshot->name) &&
+        io::Recovery::Append(
+          recovery_path, io::Journal::EncodeFrame(*p_snapshot, everything));
+    });
+}
+
+void DocumentManager::DropRecovery(Document& document) {
+  if (document.recovery_path.empty()) {
+    return;
+  }
+  recovery_queue_.Push([recovery_path = document.recovery_path]() {
+    io::Recovery::Remove(recovery_path);
+  });
+  document.recovery_path.clear();
+  document.recovery_revision = 0;
+}
+
+std::optional<Document> DocumentManager::OpenDocument(
+  const std::filesystem::path& path) {
+  auto document = ReadDocument(path);
+  if (!document) {
+    return document;
+  }
+  if (p_journal_->IsBound(path, JOURNAL_MIN_VERSION) &&
+      !p_journal_->Replay(*document, path)) {
+    // Left on disk for a build that can read it, saves rewrite the base
+    std::cerr << "Unable to replay journal: " << path << std::endl;
+    return document;
+  }
+  document->synced_path = path;
   return document;
 }
 
+DocumentHandle DocumentManager::AddDocument(
+  const std::filesystem::path& path, std::optional<Document> document) {
+  if (!document) {
+    std::cerr << "Unable to open document: " << path << std::endl;
+    return {};
+  }
+  document->path = path;
+  const auto handle = documents_.Emplace(std::move(*document));
+  tab_order_.push_back(handle);
+  return handle;
+}
+
+std::optional<Document> DocumentManager::ReadDocument(
+  const std::filesystem::path& path) {
+  switch (io::FormatFromPath(path)) {
+    case io::DocumentFormat::kBinlo: return io::BinloCodec::Read(path);
+    case io::DocumentFormat::kJsonloGz: {
+      auto p_buffer = io::GzipStreamBuf::Open(path, std::ios::in);
+      if (!p_buffer) {
+        return std::nullopt;
+      }
+      std::istream stream(p_buffer.get());
+      return io::JsonloReader::Read(stream);
+    }
+    default: break;
+  }
+  std::error_code error;
+  auto file_size = std::filesystem::file_size(path, error);
+  if (!error && file_size >= JSONLO_LAZY_MIN_BYTES) {
+    return io::JsonloReader::ReadLazy(path);
+  }
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+  return DeserializeDocument(file, error ? 0 : file_size);
+}
+
+std::optional<Document> DocumentManager::ReadDocument(std::istream& stream) {
+  return io::JsonloReader::Read(stream);
+}
+
+bool DocumentManager::WriteDocument(
+  const Document& document, std::ostream& stream) {
+  return io::JsonloWriter::Write(document, stream) && stream.flush().good();
+}
+
+bool DocumentManager::WriteDocument(const Document& document,
+  const std::filesystem::path& path, io::DocumentFormat const format) {
+  if (format == io::DocumentFormat::kBinlo) {
+    return io::BinloCodec::Write(document, path);
+  }
+  auto temp_path = path;
+  temp_path += ".tmp";
+  bool written = false;
+  if (format == io::DocumentFormat::kJsonloGz) {
+    // Deflated chunk by chunk, the whole text never sits in memory
+    if (auto p_buffer = io::GzipStreamBuf::Open(temp_path, std::ios::out)) {
+      std::ostream stream(p_buffer.get());
+      written = io::JsonloWriter::Write(document, stream) && p_buffer->Close();
+    }
+  } else {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (file.is_open()) {
+      std::string serializedData = SerializeDocument(document);
+      file.write(serializedData.c_str(), serializedData.size());
+      file.close();
+      written = file.good();
+    }
+  }
+  if (!written) {
+    std::error_code error;
+    std::filesystem::remove(temp_path, error);
+    return false;
+  }
+  return io::CommitTempFile(temp_path, path);
+}
+
+void DocumentManager::StartCompaction(const std::filesystem::path& path) {
+  if (is_compacting_.exchange(true)) {
+    return;
+  }
+  compaction_thread_ = std::jthread([this, path]() {
+    CompactJournal(path);
+    is_compacting_ = false;
+  });
+}
+
+void DocumentManager::CompactJournal(const std::filesystem::path& path) {
+  // Saves keep appending while the base is rebuilt, Rebind keeps those frames
+  const auto mark = p_journal_->Mark(path);
+  if (!mark) {
+    return;
+  }
+  auto document = ReadDocument(path);
+  if (!document || !p_journal_->Replay(*document, path, mark->length)) {
+    return;
+  }
+  auto compacted_path = path;
+  compacted_path += ".compact";
+  if (!WriteDocument(*document, compacted_path, io::FormatFromPath(path))) {
+    std::error_code error;
+    std::filesystem::remove(compacted_path, error);
+    return;
+  }
+  p_journal_->Rebind(path, compacted_path, *mark);
+}
+
+std::string DocumentManager::SerializeDocument(const Document& document) {
+  return io::JsonloWriter::Write(document);
+}
+
+std::optional<Document> DocumentManager::DeserializeDocument(
+  std::ifstream &json_file, std::uintmax_t const size_hint) {
+  return io::JsonloReader::Read(json_file, size_hint);
+}
+
 }  // namespace linea_one
\ No newline at end of file
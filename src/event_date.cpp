@@ -0,0 +1,144 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_date.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <event_date.h>
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+
+namespace linea_one {
+
+namespace {
+
+bool IsLeapYear(int const year) {
+  return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+int DaysBeforeMonth(int const year, int const month) {
+  static constexpr int kDays[] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+  return kDays[month - 1] + (month > 2 && IsLeapYear(year));
+}
+
+bool ParseTwoDigits(std::string_view const text, int& value) {
+  if (text.size() != 2) {
+    return false;
+  }
+  const auto result =
+    std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc() && result.ptr == text.data() + text.size() &&
+         value >= 0;
+}
+
+}  // namespace
+
+EventDate EventDate::Clamped(
+  int const year, int month, int day, int second) {
+  month = std::clamp(month, 0, 12);
+  day = month == 0 ? 0 : std::clamp(day, 0, DaysInMonth(year, month));
+  second = day == 0 ? -1 : std::min(second, DATE_SECONDS_PER_DAY - 1);
+  return *Make(year, month, day, second);
+}
+
+std::optional<EventDate> EventDate::Make(
+  int const year, int const month, int const day, int const second) {
+  if (month < 0 || month > 12 || day < 0 ||
+      (month == 0 && (day != 0 || second >= 0)) ||
+      (month != 0 && day > DaysInMonth(year, month)) ||
+      (day == 0 && second >= 0) || second >= DATE_SECONDS_PER_DAY) {
+    return std::nullopt;
+  }
+  auto key = EventDate(year).key_;
+  key += static_cast<int64_t>(month) << DATE_MONTH_SHIFT;
+  key += static_cast<int64_t>(day) << DATE_DAY_SHIFT;
+  key += second >= 0 ? second + 1 : 0;
+  return FromKey(key);
+}
+
+EventDate EventDate::WithYear(int const year) const {
+  return Clamped(year, Month(), Day(), HasTime() ? Second() : -1);
+}
+
+EventDate EventDate::WithMonth(int const month) const {
+  return Clamped(Year(), month, Day(), HasTime() ? Second() : -1);
+}
+
+EventDate EventDate::WithDay(int const day) const {
+  return Clamped(Year(), Month(), day, HasTime() ? Second() : -1);
+}
+
+bool EventDate::IsValid() const {
+  return Make(Year(), Month(), Day(), HasTime() ? Second() : -1).has_value();
+}
+
+double EventDate::Years() const {
+  const int year = Year();
+  if (Month() == 0) {
+    return year;
+  }
+  const double days_in_year = IsLeapYear(year) ? 366.0 : 365.0;
+  double day = DaysBeforeMonth(year, Month());
+  if (Day() != 0) {
+    day += Day() - 1 + static_cast<double>(Second()) / DATE_SECONDS_PER_DAY;
+  }
+  return year + day / days_in_year;
+}
+
+int DaysInMonth(int const year, int const month) {
+  static constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return kDays[month - 1] + (month == 2 && IsLeapYear(year));
+}
+
+std::string FormatDate(EventDate const date) {
+  if (date.Month() == 0) {
+    return std::to_string(date.Year());
+  }
+  if (date.Day() == 0) {
+    return std::format("{}-{:02}", date.Year(), date.Month());
+  }
+  if (!date.HasTime()) {
+    return std::format("{}-{:02}-{:02}", date.Year(), date.Month(), date.Day());
+  }
+  return std::format("{}-{:02}-{:02} {}", date.Year(), date.Month(), date.Day(),
+    FormatTimeOfDay(date.Second()));
+}
+
+std::string FormatTimeOfDay(int const second) {
+  return std::format(
+    "{:02}:{:02}:{:02}", second / 3600, second / 60 % 60, second % 60);
+}
+
+std::optional<int> ParseTimeOfDay(std::string_view const text) {
+  int hours = 0;
+  int minutes = 0;
+  int seconds = 0;
+  if ((text.size() != 5 && text.size() != 8) || text[2] != ':' ||
+      !ParseTwoDigits(text.substr(0, 2), hours) ||
+      !ParseTwoDigits(text.substr(3, 2), minutes) ||
+      (text.size() == 8 &&
+        (text[5] != ':' || !ParseTwoDigits(text.substr(6, 2), seconds))) ||
+      hours > 23 || minutes > 59 || seconds > 59) {
+    return std::nullopt;
+  }
+  return hours * 3600 + minutes * 60 + seconds;
+}
+
+}  // namespace linea_one
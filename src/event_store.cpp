@@ -0,0 +1,552 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_store.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <date_sort.h>
+#include <event_store.h>
+#include <parallel_for.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace linea_one {
+
+namespace {
+
+template <typename T>
+std::vector<T> Permute(
+  const std::vector<T>& column, const std::vector<uint64_t>& order) {
+  std::vector<T> permuted;
+  permuted.reserve(order.size());
+  for (const auto index : order) {
+    permuted.push_back(column[index]);
+  }
+  return permuted;
+}
+
+/* Neighbours out of order among the pairs (i, i + 1) with i in
+ * [first, last). */
+std::size_t Descents(const std::vector<EventDate>& dates,
+  std::size_t const first, std::size_t last) {
+  last = std::min(last, dates.empty() ? 0 : dates.size() - 1);
+  std::size_t descents = 0;
+  for (auto i = first; i < last; ++i) {
+    descents += dates[i + 1] < dates[i];
+  }
+  return descents;
+}
+
+/* First pair an edit at position takes part in. */
+std::size_t PairBefore(std::size_t const position) {
+  return position > 0 ? position - 1 : 0;
+}
+
+template <typename T>
+void Compact(std::vector<T>& column, const std::vector<bool>& removed) {
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    if (!removed[i]) {
+      if (kept != i) {
+        column[kept] = std::move(column[i]);
+      }
+      ++kept;
+    }
+  }
+  column.resize(kept);
+}
+
+}  // namespace
+
+void EventStore::reserve(std::size_t const capacity) {
+  // Readers pass an upper bound here, the id index grows as events arrive
+  // rather than sweeping a table sized for it on every erase
+  ids_.Write().ids.reserve(capacity);
+  dates_.Write().dates.reserve(capacity);
+  flags_.Write().reserve(capacity);
+  auto& handles = handles_.Write();
+  handles.headlines.reserve(capacity);
+  handles.descriptions.reserve(capacity);
+}
+
+void EventStore::clear() {
+  // Fresh columns, a copy sharing the old ones keeps them
+  ids_.Reset({});
+  dates_.Reset({});
+  flags_.Reset({});
+  handles_.Reset({});
+  texts_.Reset({});
+}
+
+void EventStore::resize(std::size_t const count) {
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& handles = handles_.Write();
+  for (std::size_t i = count; i < size(); ++i) {
+    dates.index.Remove(dates.dates[i].Year(), static_cast<uint32_t>(i));
+    ids.index.Remove(ids.ids[i], static_cast<uint32_t>(i));
+    ReleaseText(handles.headlines[i]);
+    ReleaseText(handles.descriptions[i]);
+  }
+  for (std::size_t i = size(); i < count; ++i) {
+    dates.index.Insert(0, static_cast<uint32_t>(i));
+    ids.index.Insert(0, static_cast<uint32_t>(i));
+  }
+  const auto edge = PairBefore(std::min(count, size()));
+  dates.descents -= Descents(dates.dates, edge, size());
+  ids.ids.resize(count);
+  dates.dates.resize(count);
+  dates.descents += Descents(dates.dates, edge, count);
+  flags_.Write().resize(count);
+  handles.headlines.resize(count);
+  handles.descriptions.resize(count);
+}
+
+void EventStore::push_back(TimelineEvent event) {
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& handles = handles_.Write();
+  auto& texts = texts_.Write();
+  const auto position = static_cast<uint32_t>(size());
+  dates.index.Insert(event.date.Year(), position);
+  ids.index.Insert(event.id, position);
+  ids.ids.push_back(event.id);
+  dates.dates.push_back(event.date);
+  dates.descents += Descents(dates.dates, PairBefore(position), position);
+  flags_.Write().push_back(event.expanded ? EVENT_FLAG_EXPANDED : 0);
+  handles.headlines.push_back(texts.Intern(event.headline));
+  handles.descriptions.push_back(texts.Intern(event.description));
+}
+
+void EventStore::insert(std::size_t const index, TimelineEvent event) {
+  if (index >= size()) {
+    push_back(std::move(event));
+    return;
+  }
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& flags = flags_.Write();
+  auto& handles = handles_.Write();
+  auto& texts = texts_.Write();
+  const auto position = static_cast<uint32_t>(index);
+  if ((size() - index) * EVENT_STORE_SHIFT_SWEEP_SHARE >= size()) {
+    dates.index.InsertBefore(event.date.Year(), position);
+    ids.index.InsertBefore(event.id, position);
+  } else {
+    // Walked from the end, so no two events share a position meanwhile
+    for (auto later = static_cast<uint32_t>(size()); later-- > position;) {
+      ids.index.Relocate(ids.ids[later], later, later + 1);
+      dates.index.Relocate(dates.dates[later].Year(), later, later + 1);
+    }
+    dates.index.Insert(event.date.Year(), position);
+    ids.index.Insert(event.id, position);
+  }
+  ids.ids.insert(ids.ids.begin() + index, event.id);
+  dates.descents -= Descents(dates.dates, PairBefore(index), index);
+  dates.dates.insert(dates.dates.begin() + index, event.date);
+  dates.descents += Descents(dates.dates, PairBefore(index), index + 1);
+  flags.insert(flags.begin() + index, event.expanded ? EVENT_FLAG_EXPANDED : 0);
+  handles.headlines.insert(
+    handles.headlines.begin() + index, texts.Intern(event.headline));
+  handles.descriptions.insert(
+    handles.descriptions.begin() + index, texts.Intern(event.description));
+}
+
+void EventStore::erase(std::size_t const index) {
+  // Nothing moves, so the indexes need no sweep either
+  if (index + 1 == size()) {
+    resize(index);
+    return;
+  }
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& flags = flags_.Write();
+  auto& handles = handles_.Write();
+  const auto position = static_cast<uint32_t>(index);
+  if ((size() - index) * EVENT_STORE_SHIFT_SWEEP_SHARE >= size()) {
+    dates.index.Erase(dates.dates[index].Year(), position);
+    ids.index.Erase(ids.ids[index], position);
+  } else {
+    dates.index.Remove(dates.dates[index].Year(), position);
+    ids.index.Remove(ids.ids[index], position);
+    for (auto later = position + 1; later < size(); ++later) {
+      ids.index.Relocate(ids.ids[later], later, later - 1);
+      dates.index.Relocate(dates.dates[later].Year(), later, later - 1);
+    }
+  }
+  ReleaseText(handles.headlines[index]);
+  ReleaseText(handles.descriptions[index]);
+  ids.ids.erase(ids.ids.begin() + index);
+  dates.descents -= Descents(dates.dates, PairBefore(index), index + 1);
+  dates.dates.erase(dates.dates.begin() + index);
+  dates.descents += Descents(dates.dates, PairBefore(index), index);
+  flags.erase(flags.begin() + index);
+  handles.headlines.erase(handles.headlines.begin() + index);
+  handles.descriptions.erase(handles.descriptions.begin() + index);
+}
+
+std::size_t EventStore::erase_ids(std::span<const uint64_t> const ids) {
+  std::vector<bool> removed(size(), false);
+  std::size_t count = 0;
+  for (const auto id : ids) {
+    if (const auto position = ids_->index.Find(id);
+        position && !removed[*position]) {
+      removed[*position] = true;
+      ++count;
+    }
+  }
+  if (count > 0) {
+    compact(removed);
+  }
+  return count;
+}
+
+void EventStore::compact(const std::vector<bool>& removed) {
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& handles = handles_.Write();
+  // The indexes keep their entries and only learn the new positions, no id
+  // is hashed and no year looked up again
+  std::vector<uint32_t> moved_to(size());
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < size(); ++i) {
+    if (removed[i]) {
+      ReleaseText(handles.headlines[i]);
+      ReleaseText(handles.descriptions[i]);
+      ids.index.Remove(ids.ids[i], i);
+      moved_to[i] = UINT32_MAX;
+    } else {
+      moved_to[i] = kept++;
+    }
+  }
+  if (kept == size()) {
+    return;
+  }
+  ids.index.Remap(moved_to);
+  dates.index.Compact(moved_to);
+  Compact(ids.ids, removed);
+  Compact(dates.dates, removed);
+  Compact(flags_.Write(), removed);
+  Compact(handles.headlines, removed);
+  Compact(handles.descriptions, removed);
+  dates.descents = Descents(dates.dates, 0, dates.dates.size());
+}
+
+void EventStore::swap(std::size_t const a, std::size_t const b) {
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& flags = flags_.Write();
+  auto& handles = handles_.Write();
+  const auto position_a = static_cast<uint32_t>(a);
+  const auto position_b = static_cast<uint32_t>(b);
+  dates.index.Swap(
+    dates.dates[a].Year(), position_a, dates.dates[b].Year(), position_b);
+  const auto [low, high] = std::minmax(a, b);
+  const auto descents = [&dates, low, high] {
+    if (high - low < 2) {
+      return Descents(dates.dates, PairBefore(low), high + 1);
+    }
+    return Descents(dates.dates, PairBefore(low), low + 1) +
+           Descents(dates.dates, high - 1, high + 1);
+  };
+  dates.descents -= descents();
+  std::swap(ids.ids[a], ids.ids[b]);
+  std::swap(dates.dates[a], dates.dates[b]);
+  dates.descents += descents();
+  std::swap(flags[a], flags[b]);
+  std::swap(handles.headlines[a], handles.headlines[b]);
+  std::swap(handles.descriptions[a], handles.descriptions[b]);
+  ids.index.Relocate(ids.ids[a], position_b, position_a);
+  ids.index.Relocate(ids.ids[b], position_a, position_b);
+}
+
+void EventStore::move(std::size_t const from, std::size_t const to) {
+  if (from == to) {
+    return;
+  }
+  auto& ids = ids_.Write();
+  auto& dates = dates_.Write();
+  auto& flags = flags_.Write();
+  auto& handles = handles_.Write();
+  const uint64_t id = ids.ids[from];
+  const int year = dates.dates[from].Year();
+  ids.index.Remove(id, static_cast<uint32_t>(from));
+  dates.index.Remove(year, static_cast<uint32_t>(from));
+  // Walked away from the gap, so no two events share a position meanwhile
+  const auto shift = [&](std::size_t const position, std::size_t const next) {
+    ids.index.Relocate(ids.ids[position], static_cast<uint32_t>(position),
+      static_cast<uint32_t>(next));
+    dates.index.Relocate(dates.dates[position].Year(),
+      static_cast<uint32_t>(position), static_cast<uint32_t>(next));
+  };
+  const auto rotate = [from, to](auto& column) {
+    if (from < to) {
+      std::rotate(column.begin() + from, column.begin() + from + 1,
+        column.begin() + to + 1);
+    } else {
+      std::rotate(column.begin() + to, column.begin() + from,
+        column.begin() + from + 1);
+    }
+  };
+  const auto distance = from < to ? to - from : from - to;
+  if (distance * EVENT_STORE_SHIFT_SWEEP_SHARE >= size()) {
+    // One pass over the indexes beats a lookup per shifted event
+    const auto first = static_cast<uint32_t>(std::min(from, to) + (from < to));
+    const auto last = static_cast<uint32_t>(std::max(from, to) - (from > to));
+    const int delta = from < to ? -1 : 1;
+    ids.index.Shift(first, last, delta);
+    dates.index.Shift(first, last, delta);
+  } else if (from < to) {
+    for (std::size_t position = from + 1; position <= to; ++position) {
+      shift(position, position - 1);
+    }
+  } else {
+    for (std::size_t position = from; position-- > to;) {
+      shift(position, position + 1);
+    }
+  }
+  // Pairs inside the rotated run only change at its ends, counting the
+  // run costs no more than rotating it
+  const auto first_pair = PairBefore(std::min(from, to));
+  const auto last_pair = std::max(from, to) + 1;
+  dates.descents -= Descents(dates.dates, first_pair, last_pair);
+  rotate(ids.ids);
+  rotate(dates.dates);
+  dates.descents += Descents(dates.dates, first_pair, last_pair);
+  rotate(flags);
+  rotate(handles.headlines);
+  rotate(handles.descriptions);
+  ids.index.Insert(id, static_cast<uint32_t>(to));
+  dates.index.Insert(year, static_cast<uint32_t>(to));
+}
+
+std::size_t EventStore::ordered_position(std::size_t const index) const {
+  const auto& dates = dates_->dates;
+  const EventDate date = dates[index];
+  if (index > 0 && date < dates[index - 1]) {
+    return std::upper_bound(dates.begin(), dates.begin() + index, date) -
+           dates.begin();
+  }
+  if (index + 1 < dates.size() && dates[index + 1] < date) {
+    // Counted with the event taken out, it lands before the first later one
+    return std::lower_bound(dates.begin() + index + 1, dates.end(), date) -
+           dates.begin() - 1;
+  }
+  return index;
+}
+
+void EventStore::reorder(const std::vector<uint64_t>& order) {
+  // Every column is rebuilt, a shared one is read rather than cloned first
+  IdColumn ids{{}, ids_->index};
+  DateColumn dates;
+  TextColumns handles;
+  std::vector<uint8_t> flags;
+  const std::function<void()> columns[] = {
+    [&] {
+      ids.ids = Permute(ids_->ids, order);
+      std::vector<uint32_t> moved_to(ids_->ids.size(), UINT32_MAX);
+      for (std::size_t i = 0; i < order.size(); ++i) {
+        moved_to[order[i]] = static_cast<uint32_t>(i);
+      }
+      // Events left out of the order are dropped, so are their ids
+      for (uint32_t i = 0; i < moved_to.size(); ++i) {
+        if (moved_to[i] == UINT32_MAX) {
+          ids.index.Remove(ids_->ids[i], i);
+        }
+      }
+      ids.index.Remap(moved_to);
+    },
+    [&] {
+      dates.dates = Permute(dates_->dates, order);
+      dates.index.Rebuild(dates.dates);
+      dates.descents = Descents(dates.dates, 0, dates.dates.size());
+    },
+    [&] { handles.headlines = Permute(handles_->headlines, order); },
+    [&] { handles.descriptions = Permute(handles_->descriptions, order); },
+    [&] { flags = Permute(*flags_, order); },
+  };
+  if (size() < PARALLEL_FOR_MIN_ITEMS) {
+    for (const auto& column : columns) {
+      column();
+    }
+  } else {
+    ParallelFor(std::size(columns),
+      [&columns](std::size_t const column) { columns[column](); });
+  }
+  flags_.Reset(std::move(flags));
+  ids_.Reset(std::move(ids));
+  dates_.Reset(std::move(dates));
+  handles_.Reset(std::move(handles));
+}
+
+EventStore::iterator EventStore::find(uint64_t const id) {
+  const auto position = ids_->index.Find(id);
+  return {this, position ? *position : size()};
+}
+
+EventStore::const_iterator EventStore::find(uint64_t const id) const {
+  const auto position = ids_->index.Find(id);
+  return {this, position ? *position : size()};
+}
+
+bool EventStore::contains(uint64_t const id) const {
+  return ids_->index.Find(id).has_value();
+}
+
+void EventStore::set_id(std::size_t const index, uint64_t const id) {
+  auto& ids = ids_.Write();
+  ids.index.Move(ids.ids[index], id, static_cast<uint32_t>(index));
+  ids.ids[index] = id;
+}
+
+uint64_t EventStore::allocate_id() { return ids_.Write().index.Allocate(); }
+
+bool EventStore::sorted_by_date() const { return dates_->descents == 0; }
+
+std::pair<int, int> EventStore::year_range() const {
+  if (dates_->index.Empty()) {
+    return {std::numeric_limits<int>::max(), std::numeric_limits<int>::min()};
+  }
+  return {dates_->index.Min(), dates_->index.Max()};
+}
+
+const YearIndex::Groups& EventStore::year_groups() const {
+  return dates_->index.All();
+}
+
+YearIndex::Range EventStore::years_between(
+  int const first, int const last) const {
+  return dates_->index.Between(first, last);
+}
+
+std::pair<std::size_t, std::size_t> EventStore::sorted_between(
+  double const first, double const last) const {
+  const auto dates = this->dates();
+  const auto begin =
+    std::ranges::lower_bound(dates, first, {}, &EventDate::Years);
+  const auto end =
+    std::ranges::upper_bound(begin, dates.end(), last, {}, &EventDate::Years);
+  return {static_cast<std::size_t>(begin - dates.begin()),
+    static_cast<std::size_t>(end - dates.begin())};
+}
+
+uint32_t EventStore::add_text_source(
+  std::shared_ptr<const TextSource> p_source) {
+  return texts_.Write().AddSource(std::move(p_source));
+}
+
+void EventStore::reserve_text(std::size_t const bytes) {
+  texts_.Write().Reserve(bytes);
+}
+
+bool EventStore::compact_text() {
+  if (!texts_->NeedsCompaction()) {
+    return false;
+  }
+  auto& handles = handles_.Write();
+  texts_.Write().Compact({handles.headlines, handles.descriptions});
+  return true;
+}
+
+std::size_t EventStore::text_size() const { return texts_->Size(); }
+
+void EventStore::set_date(std::size_t const index, EventDate const date) {
+  auto& dates = dates_.Write();
+  dates.index.Move(
+    dates.dates[index].Year(), date.Year(), static_cast<uint32_t>(index));
+  dates.descents -= Descents(dates.dates, PairBefore(index), index + 1);
+  dates.dates[index] = date;
+  dates.descents += Descents(dates.dates, PairBefore(index), index + 1);
+}
+
+void EventStore::set_flag(
+  std::size_t const index, uint8_t const mask, bool const value) {
+  auto& flags = flags_.Write()[index];
+  flags = value ? flags | mask : flags & ~mask;
+}
+
+std::string_view EventStore::text(
+  TextField const field, std::size_t const index) const {
+  if (const auto handle = text_handle(field, index); handle.source != 0) {
+    if (handles_.IsShared() || texts_.IsShared()) {
+      texts_->Fetch(handle, fetched_);
+      return fetched_;
+    }
+    Column(handles_.Write(), field)[index] = texts_.Write().Load(handle);
+  }
+  return texts_->View(text_handle(field, index));
+}
+
+TextHandle EventStore::text_handle(
+  TextField const field, std::size_t const index) const {
+  return field == TextField::kHeadline ? handles_->headlines[index]
+                                       : handles_->descriptions[index];
+}
+
+void EventStore::set_text(
+  TextField const field, std::size_t const index, std::string_view const text) {
+  auto& handle = Column(handles_.Write(), field)[index];
+  const auto previous = handle;
+  handle = texts_.Write().Intern(text);
+  if (handle.offset != previous.offset || handle.length != previous.length) {
+    ReleaseText(previous);
+  }
+}
+
+void EventStore::set_lazy_text(TextField const field, std::size_t const index,
+  uint32_t const source, uint64_t const offset, uint32_t const length) {
+  auto& handle = Column(handles_.Write(), field)[index];
+  ReleaseText(handle);
+  handle = {offset, length, source};
+}
+
+std::vector<TextHandle>& EventStore::Column(
+  TextColumns& texts, TextField const field) {
+  return field == TextField::kHeadline ? texts.headlines : texts.descriptions;
+}
+
+void EventStore::ReleaseText(const TextHandle& handle) {
+  // Garbage is an estimate, not worth cloning a shared arena to count it
+  if (!texts_.IsShared()) {
+    texts_.Write().Release(handle);
+  }
+}
+
+std::optional<std::vector<uint64_t>> EventStore::sort_by_date(
+  const std::stop_token& stop, const std::function<void(float)>& progress) {
+  const auto& dates = dates_->dates;
+  if (sorted_by_date()) {
+    return std::vector<uint64_t>{};
+  }
+  // Sorting the keys is the cheaper half, moving the columns the rest
+  auto order = SortDates(dates, stop, [&progress](float const done) {
+    if (progress) {
+      progress(done * EVENT_STORE_SORT_KEY_SHARE);
+    }
+  });
+  if (!order || stop.stop_requested()) {
+    return std::nullopt;
+  }
+  reorder(*order);
+  if (progress) {
+    progress(1.0f);
+  }
+  return order;
+}
+
+}  // namespace linea_one
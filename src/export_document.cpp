@@ -19,7 +19,7 @@
  * Created by kureii on 8/31/24
  */
 #include <export_document.h>
-#include <imgui.h>
+#include <utf8.h>
 
 #include <algorithm>
 #include <cmath>
@@ -27,6 +27,7 @@
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace linea_one {
@@ -37,12 +38,37 @@ struct EventPosition {
   int year;
 };
 
-std::string utf8ToXMLEntities(const std::string& input) {
-  std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> converter;
-  std::u32string utf32 = converter.from_bytes(input);
+// Text read from a .binlo is not validated, a malformed sequence becomes
+// U+FFFD like in JsonloWriter
+std::u32string DecodeUtf8(std::string_view const input) {
+  const auto* p_text = reinterpret_cast<const unsigned char*>(input.data());
+  const auto* p_end = p_text + input.size();
+  std::u32string utf32;
+  utf32.reserve(input.size());
+  while (p_text != p_end) {
+    if (*p_text < 0x80) {
+      utf32 += *p_text++;
+      continue;
+    }
+    const auto length = Utf8Length(p_text, p_end);
+    if (length == 0) {
+      utf32 += U'\uFFFD';
+      ++p_text;
+      continue;
+    }
+    char32_t c = *p_text & (0x7F >> length);
+    for (std::size_t i = 1; i < length; ++i) {
+      c = c << 6 | (p_text[i] & 0x3F);
+    }
+    utf32 += c;
+    p_text += length;
+  }
+  return utf32;
+}
 
+std::string utf8ToXMLEntities(std::string_view input) {
   std::ostringstream result;
-  for (char32_t c : utf32) {
+  for (char32_t c : DecodeUtf8(input)) {
     if (c <= 127) {
       switch (c) {
         case '&':  result << "&amp;";  break;
@@ -59,8 +85,23 @@ std::string utf8ToXMLEntities(const std::string& input) {
   return result.str();
 }
 
+ExportDocument::ExportDocument() : ExportDocument(TextWidth(EstimateTextWidth)) {}
+
+ExportDocument::ExportDocument(TextWidth text_width)
+  : text_width_(std::move(text_width)) {}
+
+ExportDocument::ExportDocument(std::shared_ptr<TextMeasureCache> p_text_cache)
+  : p_text_cache_(std::move(p_text_cache)) {}
+
+float ExportDocument::EstimateTextWidth(std::string_view const text) {
+  // Continuation bytes do not start a glyph
+  auto glyphs = std::ranges::count_if(
+    text, [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; });
+  return static_cast<float>(glyphs) * EXPORT_GLYPH_WIDTH;
+}
+
 std::string ExportDocument::ExportTimelineToSVG(
-  const std::vector<TimelineEvent>& events, const TimelineState& state) {
+  const EventStore& events, const TimelineState& state) {
   const float minPointWidth = 100.0f;
   const float padding = 20.0f;
   const int baseHeight = 250;
@@ -68,21 +109,19 @@ std::string ExportDocument::ExportTimelineToSVG(
   const float yearTextY = baseHeight / 2 + 20;
   const float circleY = baseHeight / 2;
 
-  auto getTextWidth = [](const std::string& text) {
-    return ImGui::CalcTextSize(text.c_str()).x;
+  auto getTextWidth = [this](std::string_view text) {
+    return p_text_cache_ ? p_text_cache_->Width(text) : text_width_(text);
   };
 
-  std::map<int, std::vector<const TimelineEvent*>> eventsByYear;
-  for (const auto& event : events) {
-    eventsByYear[event.year].push_back(&event);
-  }
+  // Maintained by the store, nothing to group here
+  const auto& eventsByYear = events.year_groups();
 
   float totalWidth = 0.0f;
   std::map<int, float> yearXPositions;
   for (const auto& [year, yearEvents] : eventsByYear) {
     float maxWidth = minPointWidth;
-    for (const auto* event : yearEvents) {
-      float headlineWidth = getTextWidth(event->headline);
+    for (const auto index : yearEvents) {
+      float headlineWidth = getTextWidth(events[index].headline);
       maxWidth = std::max(maxWidth, headlineWidth);
     }
     float width = maxWidth + padding;
@@ -115,7 +154,7 @@ std::string ExportDocument::ExportTimelineToSVG(
   for (const auto& [year, yearEvents] : eventsByYear) {
     float x = yearXPositions[year];
     for (size_t i = 0; i < yearEvents.size(); ++i) {
-      const auto* event = yearEvents[i];
+      const auto event = events[yearEvents[i]];
       float textY = circleY - 15 - (i * textHeight);
 
       svg << "<g>\n"
@@ -123,8 +162,8 @@ std::string ExportDocument::ExportTimelineToSVG(
           << "  <text x=\"" << x << "\" y=\"" << yearTextY
           << "\" text-anchor=\"middle\" class=\"year\">" << year << "</text>\n"
           << "  <text x=\"" << x << "\" y=\"" << textY
-          << "\" text-anchor=\"middle\" class=\"headline\">" << utf8ToXMLEntities(event->headline) << "</text>\n"
-          << "  <text x=\"" << x << "\" y=\"0\" class=\"description\">" << utf8ToXMLEntities(event->description) << "</text>\n"
+          << "\" text-anchor=\"middle\" class=\"headline\">" << utf8ToXMLEntities(event.headline) << "</text>\n"
+          << "  <text x=\"" << x << "\" y=\"0\" class=\"description\">" << utf8ToXMLEntities(event.description) << "</text>\n"
           << "</g>\n";
     }
   }
@@ -133,7 +172,7 @@ std::string ExportDocument::ExportTimelineToSVG(
   return svg.str();
 }
 
-void ExportDocument::SaveTimelineAsSVG(const std::vector<TimelineEvent>& events,
+void ExportDocument::SaveTimelineAsSVG(const EventStore& events,
   const TimelineState& state, const std::filesystem::path path) {
   std::string svgContent = ExportTimelineToSVG(events, state);
   std::ofstream file(path);
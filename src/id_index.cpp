@@ -0,0 +1,183 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: id_index.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <id_index.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace linea_one {
+
+void IdIndex::Insert(uint64_t const id, uint32_t const position) {
+  next_id_ = std::max(next_id_, id + 1);
+  if ((count_ + 1) * 10 > positions_.size() * 7) {
+    Grow(std::max<std::size_t>(ID_INDEX_INITIAL_SLOTS, positions_.size() * 2));
+  }
+  const std::size_t slot = SlotOf(id);
+  if (positions_[slot] == kEmptySlot) {
+    ids_[slot] = id;
+    positions_[slot] = position;
+    ++count_;
+  }
+}
+
+void IdIndex::Remove(uint64_t const id, uint32_t const position) {
+  if (count_ == 0) {
+    return;
+  }
+  std::size_t hole = SlotOf(id);
+  if (positions_[hole] != position) {
+    return;
+  }
+  // Backward shift instead of tombstones: later entries of the probe chain
+  // move up into the hole when that is still on their way from home
+  const std::size_t mask = positions_.size() - 1;
+  for (std::size_t next = (hole + 1) & mask; positions_[next] != kEmptySlot;
+       next = (next + 1) & mask) {
+    const std::size_t home = Home(ids_[next]);
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      ids_[hole] = ids_[next];
+      positions_[hole] = positions_[next];
+      hole = next;
+    }
+  }
+  positions_[hole] = kEmptySlot;
+  --count_;
+}
+
+void IdIndex::Relocate(
+  uint64_t const id, uint32_t const from, uint32_t const to) {
+  if (count_ == 0) {
+    return;
+  }
+  if (auto& position = positions_[SlotOf(id)]; position == from) {
+    position = to;
+  }
+}
+
+void IdIndex::Move(uint64_t const from, uint64_t const to,
+  uint32_t const position) {
+  if (from == to) {
+    return;
+  }
+  Remove(from, position);
+  Insert(to, position);
+}
+
+void IdIndex::Shift(
+  uint32_t const first, uint32_t const last, int const delta) {
+  // Empty slots hold UINT32_MAX and are never in range
+  for (auto& position : positions_) {
+    position += delta * ((position >= first) & (position <= last));
+  }
+}
+
+void IdIndex::Erase(uint64_t const id, uint32_t const position) {
+  Remove(id, position);
+  // Empty slots hold UINT32_MAX and have to stay so
+  for (auto& later : positions_) {
+    later -= (later > position) & (later != kEmptySlot);
+  }
+}
+
+void IdIndex::InsertBefore(uint64_t const id, uint32_t const position) {
+  for (auto& later : positions_) {
+    later += (later >= position) & (later != kEmptySlot);
+  }
+  Insert(id, position);
+}
+
+void IdIndex::Rebuild(std::span<const uint64_t> const ids) {
+  std::ranges::fill(positions_, kEmptySlot);
+  count_ = 0;
+  Reserve(ids.size());
+  for (uint32_t i = 0; i < ids.size(); ++i) {
+    Insert(ids[i], i);
+  }
+}
+
+void IdIndex::Remap(std::span<const uint32_t> const moved_to) {
+  for (auto& position : positions_) {
+    if (position != kEmptySlot) {
+      position = moved_to[position];
+    }
+  }
+}
+
+void IdIndex::Reserve(std::size_t const count) {
+  std::size_t slots = std::max<std::size_t>(ID_INDEX_INITIAL_SLOTS, positions_.size());
+  while (count * 10 > slots * 7) {
+    slots *= 2;
+  }
+  if (slots != positions_.size()) {
+    Grow(slots);
+  }
+}
+
+void IdIndex::Clear() {
+  ids_.clear();
+  positions_.clear();
+  count_ = 0;
+  shift_ = 64;
+}
+
+std::optional<uint32_t> IdIndex::Find(uint64_t const id) const {
+  if (count_ == 0) {
+    return std::nullopt;
+  }
+  const auto position = positions_[SlotOf(id)];
+  if (position == kEmptySlot) {
+    return std::nullopt;
+  }
+  return position;
+}
+
+uint64_t IdIndex::Allocate() { return next_id_++; }
+
+std::size_t IdIndex::Home(uint64_t const id) const {
+  // Fibonacci hashing spreads the mostly sequential ids over the table
+  return static_cast<std::size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_);
+}
+
+std::size_t IdIndex::SlotOf(uint64_t const id) const {
+  const std::size_t mask = positions_.size() - 1;
+  std::size_t slot = Home(id);
+  while (positions_[slot] != kEmptySlot && ids_[slot] != id) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void IdIndex::Grow(std::size_t const slots) {
+  auto ids = std::move(ids_);
+  auto positions = std::move(positions_);
+  ids_.assign(slots, 0);
+  positions_.assign(slots, kEmptySlot);
+  shift_ = 64 - std::countr_zero(slots);
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    if (positions[i] != kEmptySlot) {
+      const std::size_t slot = SlotOf(ids[i]);
+      ids_[slot] = ids[i];
+      positions_[slot] = positions[i];
+    }
+  }
+}
+
+}  // namespace linea_one
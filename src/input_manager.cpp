@@ -37,10 +37,19 @@ uint32_t InputManager::HandleShortcuts() {
     }
     if (ImGui::IsKeyPressed(ImGuiKey_W) && action_key != ASCII_W) {
       if (p_doc_man_->CloseDocumentWithCheck(
-            p_doc_man_->GetCurrentDocumentIndex()) >= 0) {
+            p_doc_man_->GetCurrentDocumentHandle()) == CloseResult::kUnsaved) {
         action_key = ASCII_W;
       }
     }
+    // Text fields keep their own undo while they are being typed into
+    if (!io.WantTextInput) {
+      if (ImGui::IsKeyPressed(ImGuiKey_Z) && action_key != ASCII_Z) {
+        action_key = ASCII_Z;
+      }
+      if (ImGui::IsKeyPressed(ImGuiKey_Y) && action_key != ASCII_Y) {
+        action_key = ASCII_Y;
+      }
+    }
   }
 
   if (io.KeyShift) {
@@ -74,6 +83,11 @@ uint32_t InputManager::HandleShortcuts() {
       ImGui::IsKeyReleased(ImGuiKey_RightCtrl)) {
     action_key = 0;
   }
+  if (ImGui::IsKeyReleased(ImGuiKey_Z) || ImGui::IsKeyReleased(ImGuiKey_Y) ||
+      ImGui::IsKeyReleased(ImGuiKey_LeftCtrl) ||
+      ImGui::IsKeyReleased(ImGuiKey_RightCtrl)) {
+    action_key = 0;
+  }
 
   return action_key;
 }
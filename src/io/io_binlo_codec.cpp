@@ -0,0 +1,251 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_binlo_codec.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_binlo_codec.h>
+#include <io/io_file_sync.h>
+#include <io/io_mapped_file.h>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace linea_one::io {
+
+static_assert(std::endian::native == std::endian::little,
+  ".binlo is stored in little-endian byte order");
+
+namespace {
+
+constexpr uint64_t AlignUp(const uint64_t value) { return (value + 7) & ~7ull; }
+
+template <typename T>
+T LoadValue(const std::byte* p_data) {
+  T value;
+  std::memcpy(&value, p_data, sizeof(T));
+  return value;
+}
+
+class MappedTextSource final : public TextSource {
+ public:
+  MappedTextSource(std::shared_ptr<MappedFile> p_file, const std::byte* p_blob)
+    : p_file_(std::move(p_file)), p_blob_(p_blob) {}
+
+  void Fetch(const uint64_t offset, const uint64_t length,
+    std::string& text) const override {
+    text.assign(reinterpret_cast<const char*>(p_blob_ + offset), length);
+  }
+
+ private:
+  std::shared_ptr<MappedFile> p_file_;
+  const std::byte* p_blob_;
+};
+
+bool SectionFits(const uint64_t offset, const uint64_t count,
+  const uint64_t element_size, const uint64_t file_size) {
+  if (offset > file_size || offset % 8 != 0) {
+    return false;
+  }
+  return count <= (file_size - offset) / element_size;
+}
+
+bool OffsetsValid(const std::byte* p_offsets, const uint64_t count,
+  const uint64_t blob_size) {
+  uint64_t previous = 0;
+  for (uint64_t i = 0; i <= count; ++i) {
+    const auto current = LoadValue<uint64_t>(p_offsets + i * sizeof(uint64_t));
+    if (current < previous || current > blob_size) {
+      return false;
+    }
+    previous = current;
+  }
+  return true;
+}
+
+void WritePadding(std::ofstream& file) {
+  static constexpr char kZeros[8] = {};
+  const auto position = static_cast<uint64_t>(file.tellp());
+  file.write(kZeros, static_cast<std::streamsize>(AlignUp(position) - position));
+}
+
+template <typename T>
+void WriteColumn(std::ofstream& file, std::span<const T> column) {
+  file.write(reinterpret_cast<const char*>(column.data()),
+    static_cast<std::streamsize>(column.size() * sizeof(T)));
+  WritePadding(file);
+}
+
+}  // namespace
+
+std::optional<Document> BinloCodec::Read(const std::filesystem::path& path) {
+  const auto p_file = MappedFile::Open(path);
+  if (!p_file || p_file->Size() < sizeof(BinloHeader)) {
+    return std::nullopt;
+  }
+  const std::byte* p_data = p_file->Data();
+  const uint64_t file_size = p_file->Size();
+  const auto header = LoadValue<BinloHeader>(p_data);
+  const uint64_t count = header.event_count;
+  // Version 1 stored whole years
+  const uint64_t date_size =
+    header.version == 1 ? sizeof(int32_t) : sizeof(int64_t);
+
+  if (std::memcmp(header.magic, BINLO_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version < 1 || header.version > BINLO_VERSION ||
+      header.header_size != sizeof(BinloHeader) ||
+      !SectionFits(header.ids_offset, count, sizeof(uint64_t), file_size) ||
+      !SectionFits(header.dates_offset, count, date_size, file_size) ||
+      !SectionFits(header.flags_offset, count, sizeof(uint8_t), file_size) ||
+      count == UINT64_MAX ||
+      !SectionFits(header.headline_offsets_offset, count + 1,
+        sizeof(uint64_t), file_size) ||
+      !SectionFits(header.description_offsets_offset, count + 1,
+        sizeof(uint64_t), file_size) ||
+      !SectionFits(header.blob_offset, header.blob_size, 1, file_size) ||
+      header.name_offset > header.blob_size ||
+      header.name_length > header.blob_size - header.name_offset) {
+    return std::nullopt;
+  }
+
+  const std::byte* p_ids = p_data + header.ids_offset;
+  const std::byte* p_dates = p_data + header.dates_offset;
+  const std::byte* p_flags = p_data + header.flags_offset;
+  const std::byte* p_headlines = p_data + header.headline_offsets_offset;
+  const std::byte* p_descriptions = p_data + header.description_offsets_offset;
+  const std::byte* p_blob = p_data + header.blob_offset;
+  if (!OffsetsValid(p_headlines, count, header.blob_size) ||
+      !OffsetsValid(p_descriptions, count, header.blob_size)) {
+    return std::nullopt;
+  }
+
+  Document document{};
+  document.name = std::string(
+    reinterpret_cast<const char*>(p_blob + header.name_offset),
+    header.name_length);
+  document.saved = true;
+  document.state.zoom = header.zoom;
+  document.state.offset = header.offset;
+  document.events.reserve(count);
+
+  const auto source = document.events.add_text_source(
+    std::make_shared<MappedTextSource>(p_file, p_blob));
+  for (uint64_t i = 0; i < count; ++i) {
+    const auto headline = LoadValue<uint64_t>(p_headlines + i * 8);
+    const auto headline_end = LoadValue<uint64_t>(p_headlines + i * 8 + 8);
+    const auto description = LoadValue<uint64_t>(p_descriptions + i * 8);
+    const auto description_end =
+      LoadValue<uint64_t>(p_descriptions + i * 8 + 8);
+    const auto date = date_size == sizeof(int32_t)
+      ? EventDate(LoadValue<int32_t>(p_dates + i * date_size))
+      : EventDate::FromKey(LoadValue<int64_t>(p_dates + i * date_size));
+    if (!date.IsValid()) {
+      return std::nullopt;
+    }
+    auto event = document.events.emplace_back(LoadValue<uint64_t>(p_ids + i * 8),
+      date, "", (LoadValue<uint8_t>(p_flags + i) & BINLO_FLAG_EXPANDED) != 0, "");
+    event.headline.SetLazy(
+      source, headline, static_cast<uint32_t>(headline_end - headline));
+    event.description.SetLazy(source, description,
+      static_cast<uint32_t>(description_end - description));
+  }
+  return document;
+}
+
+bool BinloCodec::Write(
+  const Document& document, const std::filesystem::path& path) {
+  static_assert(EVENT_FLAG_EXPANDED == BINLO_FLAG_EXPANDED &&
+                sizeof(EventDate) == sizeof(int64_t));
+  // ids, dates and flags are written straight from the event columns
+  const auto& events = document.events;
+  const uint64_t count = events.size();
+  std::vector<uint64_t> headline_offsets(count + 1);
+  std::vector<uint64_t> description_offsets(count + 1);
+
+  BinloHeader header{};
+  std::memcpy(header.magic, BINLO_MAGIC, sizeof(header.magic));
+  header.version = BINLO_VERSION;
+  header.header_size = sizeof(BinloHeader);
+  header.event_count = count;
+  header.zoom = document.state.zoom;
+  header.offset = document.state.offset;
+  header.name_offset = 0;
+  header.name_length = document.name.size();
+
+  uint64_t blob_cursor = header.name_length;
+  for (uint64_t i = 0; i < count; ++i) {
+    headline_offsets[i] = blob_cursor;
+    blob_cursor += events[i].headline.str().size();
+  }
+  headline_offsets[count] = blob_cursor;
+  for (uint64_t i = 0; i < count; ++i) {
+    description_offsets[i] = blob_cursor;
+    blob_cursor += events[i].description.str().size();
+  }
+  description_offsets[count] = blob_cursor;
+
+  header.ids_offset = AlignUp(sizeof(BinloHeader));
+  header.dates_offset = AlignUp(header.ids_offset + count * sizeof(uint64_t));
+  header.flags_offset = AlignUp(header.dates_offset + count * sizeof(int64_t));
+  header.headline_offsets_offset =
+    AlignUp(header.flags_offset + count * sizeof(uint8_t));
+  header.description_offsets_offset = AlignUp(
+    header.headline_offsets_offset + (count + 1) * sizeof(uint64_t));
+  header.blob_offset = AlignUp(
+    header.description_offsets_offset + (count + 1) * sizeof(uint64_t));
+  header.blob_size = blob_cursor;
+
+  auto temp_path = path;
+  temp_path += ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(BinloHeader));
+    WritePadding(file);
+    WriteColumn(file, events.ids());
+    WriteColumn(file, events.dates());
+    WriteColumn(file, events.flags());
+    WriteColumn<uint64_t>(file, headline_offsets);
+    WriteColumn<uint64_t>(file, description_offsets);
+    file.write(document.name.data(),
+      static_cast<std::streamsize>(document.name.size()));
+    for (const auto event : events) {
+      const auto headline = event.headline.str();
+      file.write(headline.data(), static_cast<std::streamsize>(headline.size()));
+    }
+    for (const auto event : events) {
+      const auto description = event.description.str();
+      file.write(
+        description.data(), static_cast<std::streamsize>(description.size()));
+    }
+    file.close();
+    if (!file.good()) {
+      std::error_code error;
+      std::filesystem::remove(temp_path, error);
+      return false;
+    }
+  }
+
+  return CommitTempFile(temp_path, path);
+}
+
+}  // namespace linea_one::io
@@ -0,0 +1,88 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_file_sync.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_file_sync.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace linea_one::io {
+
+#if defined(_WIN32) || defined(_WIN64)
+
+bool SyncFile(const std::filesystem::path& path) {
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  const bool synced = FlushFileBuffers(file) != 0;
+  CloseHandle(file);
+  return synced;
+}
+
+#else
+
+namespace {
+
+bool SyncDescriptor(const std::filesystem::path& path, int flags) {
+  const int descriptor = open(path.c_str(), flags);
+  if (descriptor < 0) {
+    return false;
+  }
+  const bool synced = fsync(descriptor) == 0;
+  close(descriptor);
+  return synced;
+}
+
+}  // namespace
+
+bool SyncFile(const std::filesystem::path& path) {
+  return SyncDescriptor(path, O_RDONLY);
+}
+
+#endif
+
+bool CommitTempFile(
+  const std::filesystem::path& temp_path, const std::filesystem::path& path) {
+  std::error_code error;
+  if (!SyncFile(temp_path)) {
+    std::filesystem::remove(temp_path, error);
+    return false;
+  }
+  std::filesystem::rename(temp_path, path, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+    return false;
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  // The rename itself only lands once the directory entry is synced
+  auto directory = path.parent_path();
+  SyncDescriptor(directory.empty() ? "." : directory, O_RDONLY | O_DIRECTORY);
+#endif
+  return true;
+}
+
+}  // namespace linea_one::io
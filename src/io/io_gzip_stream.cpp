@@ -0,0 +1,134 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_gzip_stream.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_gzip_stream.h>
+
+#include <zlib.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace linea_one::io {
+
+std::unique_ptr<GzipStreamBuf> GzipStreamBuf::Open(
+  const std::filesystem::path& path, std::ios::openmode const mode) {
+  const bool writing = (mode & std::ios::out) != 0;
+  // zlib's default level, saving runs off the UI thread anyway
+  const char* gz_mode = writing ? "wb6" : "rb";
+#if defined(_WIN32) || defined(_WIN64)
+  gzFile file = gzopen_w(path.c_str(), gz_mode);
+#else
+  gzFile file = gzopen(path.c_str(), gz_mode);
+#endif
+  if (file == nullptr) {
+    return nullptr;
+  }
+  gzbuffer(file, GZIP_BUFFER_BYTES);
+  return std::unique_ptr<GzipStreamBuf>(new GzipStreamBuf(file, writing));
+}
+
+std::unique_ptr<GzipStreamBuf> GzipStreamBuf::Open(
+  int const descriptor, std::ios::openmode const mode) {
+  const bool writing = (mode & std::ios::out) != 0;
+#if defined(_WIN32) || defined(_WIN64)
+  const int duplicate = _dup(descriptor);
+#else
+  const int duplicate = dup(descriptor);
+#endif
+  if (duplicate < 0) {
+    return nullptr;
+  }
+  gzFile file = gzdopen(duplicate, writing ? "wb6" : "rb");
+  if (file == nullptr) {
+#if defined(_WIN32) || defined(_WIN64)
+    _close(duplicate);
+#else
+    close(duplicate);
+#endif
+    return nullptr;
+  }
+  gzbuffer(file, GZIP_BUFFER_BYTES);
+  return std::unique_ptr<GzipStreamBuf>(new GzipStreamBuf(file, writing));
+}
+
+GzipStreamBuf::GzipStreamBuf(void* p_file, bool const writing)
+  : p_file_(p_file), writing_(writing), buffer_(GZIP_BUFFER_BYTES) {
+  if (writing_) {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  } else {
+    setg(buffer_.data(), buffer_.data(), buffer_.data());
+  }
+}
+
+GzipStreamBuf::~GzipStreamBuf() { Close(); }
+
+bool GzipStreamBuf::Close() {
+  if (p_file_ == nullptr) {
+    return true;
+  }
+  const bool flushed = !writing_ || FlushBuffer();
+  const bool closed = gzclose(static_cast<gzFile>(p_file_)) == Z_OK;
+  p_file_ = nullptr;
+  return flushed && closed;
+}
+
+GzipStreamBuf::int_type GzipStreamBuf::underflow() {
+  if (writing_ || p_file_ == nullptr) {
+    return traits_type::eof();
+  }
+  const int read = gzread(static_cast<gzFile>(p_file_), buffer_.data(),
+    static_cast<unsigned>(buffer_.size()));
+  if (read <= 0) {
+    return traits_type::eof();
+  }
+  setg(buffer_.data(), buffer_.data(), buffer_.data() + read);
+  return traits_type::to_int_type(buffer_[0]);
+}
+
+GzipStreamBuf::int_type GzipStreamBuf::overflow(int_type const character) {
+  if (!writing_ || p_file_ == nullptr || !FlushBuffer()) {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(character, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(character);
+    pbump(1);
+  }
+  return traits_type::not_eof(character);
+}
+
+int GzipStreamBuf::sync() {
+  return !writing_ || (p_file_ != nullptr && FlushBuffer()) ? 0 : -1;
+}
+
+bool GzipStreamBuf::FlushBuffer() {
+  const auto pending = static_cast<unsigned>(pptr() - pbase());
+  if (pending > 0 &&
+      gzwrite(static_cast<gzFile>(p_file_), pbase(), pending) !=
+        static_cast<int>(pending)) {
+    return false;
+  }
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+  return true;
+}
+
+}  // namespace linea_one::io
@@ -0,0 +1,489 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_journal.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_file_sync.h>
+#include <io/io_journal.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace linea_one::io {
+
+namespace {
+
+enum RecordType : uint8_t {
+  // Whole year only, still replayed from journals written before dates
+  kRecordEvent = 1,
+  kRecordDelete,
+  kRecordOrder,
+  kRecordState,
+  kRecordDatedEvent
+};
+
+constexpr uint64_t kHeaderSize = 8 + 4 + 4 + 8 + 8;
+constexpr uint64_t kFrameHeaderSize = 8 + 4;
+
+uint32_t Checksum(const char* p_data, const uint64_t size) {
+  // FNV-1a, only has to catch torn or garbage frames
+  uint32_t hash = 2166136261u;
+  for (uint64_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(p_data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+class FrameWriter {
+ public:
+  template <typename T>
+  void Put(const T value) {
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  void PutText(std::string_view const text) {
+    Put(static_cast<uint32_t>(text.size()));
+    buffer_.append(text);
+  }
+  [[nodiscard]] std::string Take() { return std::move(buffer_); }
+
+ private:
+  std::string buffer_;
+};
+
+class FrameReader {
+ public:
+  FrameReader(const char* p_data, const uint64_t size)
+    : p_data_(p_data), size_(size) {}
+
+  template <typename T>
+  bool Get(T& value) {
+    if (size_ - position_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, p_data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+  bool GetText(std::string_view& text) {
+    uint32_t length = 0;
+    if (!Get(length) || size_ - position_ < length) {
+      return false;
+    }
+    text = std::string_view(p_data_ + position_, length);
+    position_ += length;
+    return true;
+  }
+  [[nodiscard]] bool AtEnd() const { return position_ == size_; }
+
+ private:
+  const char* p_data_;
+  uint64_t size_;
+  uint64_t position_ = 0;
+};
+
+/* Applies records to the events, deletes are resolved once at the end. */
+class Replayer {
+ public:
+  explicit Replayer(Document& document)
+    : document_(document), removed_(document.events.size(), false) {}
+
+  bool Apply(FrameReader& reader) {
+    while (!reader.AtEnd()) {
+      uint8_t type = 0;
+      if (!reader.Get(type)) {
+        return false;
+      }
+      switch (type) {
+        case kRecordEvent:
+        case kRecordDatedEvent: {
+          uint64_t id = 0;
+          EventDate date;
+          uint8_t expanded = 0;
+          std::string_view headline, description;
+          if (!reader.Get(id) || !GetDate(reader, type, date) ||
+              !reader.Get(expanded) || !reader.GetText(headline) ||
+              !reader.GetText(description)) {
+            return false;
+          }
+          // Texts go from the frame straight into the arena
+          auto found = document_.events.find(id);
+          if (found == document_.events.end()) {
+            removed_.push_back(false);
+            document_.events.emplace_back(id);
+            found = document_.events.end() - 1;
+          }
+          // Deleted earlier in the replay and written again keeps its place
+          removed_[found.Index()] = false;
+          auto event = *found;
+          event.date = date;
+          event.expanded = expanded != 0;
+          event.headline = headline;
+          event.description = description;
+          break;
+        }
+        case kRecordDelete: {
+          uint64_t id = 0;
+          if (!reader.Get(id)) {
+            return false;
+          }
+          if (auto found = document_.events.find(id);
+              found != document_.events.end()) {
+            removed_[found.Index()] = true;
+          }
+          break;
+        }
+        case kRecordOrder: {
+          uint64_t count = 0;
+          if (!reader.Get(count)) {
+            return false;
+          }
+          std::vector<uint64_t> order;
+          order.reserve(document_.events.size());
+          std::vector<bool> placed(document_.events.size(), false);
+          for (uint64_t i = 0; i < count; ++i) {
+            uint64_t id = 0;
+            if (!reader.Get(id)) {
+              return false;
+            }
+            const auto found = document_.events.find(id);
+            if (found == document_.events.end()) {
+              continue;
+            }
+            const auto position = found.Index();
+            if (!placed[position] && !removed_[position]) {
+              placed[position] = true;
+              order.push_back(position);
+            }
+          }
+          // Events the order does not know about keep their relative order
+          for (uint64_t i = 0; i < document_.events.size(); ++i) {
+            if (!placed[i] && !removed_[i]) {
+              order.push_back(i);
+            }
+          }
+          // Deleted events are left out, so this also drops them
+          document_.events.reorder(order);
+          removed_.assign(document_.events.size(), false);
+          break;
+        }
+        case kRecordState:
+          if (!reader.Get(document_.state.zoom) ||
+              !reader.Get(document_.state.offset)) {
+            return false;
+          }
+          break;
+        default: return false;
+      }
+    }
+    return true;
+  }
+
+  void Finish() { document_.events.compact(removed_); }
+
+ private:
+  static bool GetDate(FrameReader& reader, uint8_t const type, EventDate& date) {
+    if (type == kRecordEvent) {
+      int32_t year = 0;
+      if (!reader.Get(year)) {
+        return false;
+      }
+      date = year;
+      return true;
+    }
+    int64_t key = 0;
+    if (!reader.Get(key)) {
+      return false;
+    }
+    date = EventDate::FromKey(key);
+    return date.IsValid();
+  }
+
+  Document& document_;
+  std::vector<bool> removed_;
+};
+
+std::string ReadBytes(const std::filesystem::path& path, const uint64_t from,
+  const uint64_t limit) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return {};
+  }
+  file.seekg(static_cast<std::streamoff>(from));
+  std::string bytes;
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (!error && size > from) {
+    bytes.resize(std::min<uint64_t>(size - from, limit));
+    file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    bytes.resize(static_cast<uint64_t>(file.gcount()));
+  }
+  return bytes;
+}
+
+}  // namespace
+
+std::filesystem::path Journal::PathFor(const std::filesystem::path& base_path) {
+  auto journal_path = base_path;
+  journal_path += JOURNAL_EXTENSION;
+  return journal_path;
+}
+
+JournalFingerprint Journal::FingerprintOf(
+  const std::filesystem::path& base_path) {
+  std::error_code error;
+  JournalFingerprint fingerprint;
+  fingerprint.size = std::filesystem::file_size(base_path, error);
+  if (error) {
+    return {};
+  }
+  fingerprint.modified = std::filesystem::last_write_time(base_path, error)
+                           .time_since_epoch()
+                           .count();
+  return fingerprint;
+}
+
+bool Journal::Reset(const std::filesystem::path& base_path) {
+  auto lock = Lock();
+  return WriteHeader(PathFor(base_path), FingerprintOf(base_path));
+}
+
+bool Journal::IsBound(
+  const std::filesystem::path& base_path, uint32_t const min_version) {
+  auto lock = Lock();
+  const auto fingerprint = ReadHeader(PathFor(base_path), min_version);
+  return fingerprint && *fingerprint == FingerprintOf(base_path);
+}
+
+std::string Journal::EncodeFrame(
+  const Document& document, const DocumentDelta& delta) {
+  FrameWriter writer;
+  // Size and checksum are filled in once the payload is known
+  writer.Put(uint64_t{0});
+  writer.Put(uint32_t{0});
+  writer.Put(kRecordState);
+  writer.Put(document.state.zoom);
+  writer.Put(document.state.offset);
+
+  // Looked up by id and written in document order, new events replay in
+  // the order they were added
+  std::vector<std::size_t> changed;
+  changed.reserve(delta.changed.size());
+  for (const auto id : delta.changed) {
+    if (auto found = document.events.find(id); found != document.events.end()) {
+      changed.push_back(found.Index());
+    }
+  }
+  std::ranges::sort(changed);
+  for (const auto i : changed) {
+    const auto event = document.events[i];
+    writer.Put(kRecordDatedEvent);
+    writer.Put(event.id);
+    writer.Put(event.date.Key());
+    writer.Put(static_cast<uint8_t>(event.expanded));
+    writer.PutText(event.headline.str());
+    writer.PutText(event.description.str());
+  }
+  for (const auto id : delta.deleted) {
+    writer.Put(kRecordDelete);
+    writer.Put(id);
+  }
+  if (delta.order_changed) {
+    writer.Put(kRecordOrder);
+    writer.Put(static_cast<uint64_t>(document.events.size()));
+    for (const auto id : document.events.ids()) {
+      writer.Put(id);
+    }
+  }
+
+  auto frame = writer.Take();
+  const uint64_t payload_size = frame.size() - kFrameHeaderSize;
+  const uint32_t checksum =
+    Checksum(frame.data() + kFrameHeaderSize, payload_size);
+  std::memcpy(frame.data(), &payload_size, sizeof(payload_size));
+  std::memcpy(frame.data() + 8, &checksum, sizeof(checksum));
+  return frame;
+}
+
+std::optional<uint64_t> Journal::ApplyFrames(
+  Document& document, const char* p_data, const uint64_t size) {
+  Replayer replayer(document);
+  uint64_t position = 0;
+  while (size - position >= kFrameHeaderSize) {
+    uint64_t payload_size = 0;
+    uint32_t checksum = 0;
+    std::memcpy(&payload_size, p_data + position, sizeof(payload_size));
+    std::memcpy(&checksum, p_data + position + 8, sizeof(checksum));
+    const char* p_payload = p_data + position + kFrameHeaderSize;
+    if (size - position - kFrameHeaderSize < payload_size ||
+        Checksum(p_payload, payload_size) != checksum) {
+      break;
+    }
+    FrameReader reader(p_payload, payload_size);
+    if (!replayer.Apply(reader)) {
+      // Written whole by some build, so not ours to cut off
+      replayer.Finish();
+      return std::nullopt;
+    }
+    position += kFrameHeaderSize + payload_size;
+  }
+  replayer.Finish();
+  return position;
+}
+
+bool Journal::Append(const Document& document, const DocumentDelta& delta,
+  const std::filesystem::path& base_path) {
+  return AppendFrame(EncodeFrame(document, delta), base_path);
+}
+
+bool Journal::AppendFrame(
+  const std::string& frame, const std::filesystem::path& base_path) {
+  auto lock = Lock();
+  if (!IsBound(base_path)) {
+    return false;
+  }
+  std::ofstream file(PathFor(base_path), std::ios::binary | std::ios::app);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+  file.close();
+  return file.good() && SyncFile(PathFor(base_path));
+}
+
+bool Journal::Replay(Document& document, const std::filesystem::path& base_path,
+  const uint64_t limit) {
+  auto lock = Lock();
+  const auto journal_path = PathFor(base_path);
+  if (!IsBound(base_path, JOURNAL_MIN_VERSION)) {
+    return false;
+  }
+  const auto bytes = ReadBytes(journal_path, kHeaderSize,
+    limit == UINT64_MAX ? limit : limit - kHeaderSize);
+  const auto position = ApplyFrames(document, bytes.data(), bytes.size());
+  if (!position) {
+    return false;
+  }
+
+  if (limit == UINT64_MAX && *position != bytes.size()) {
+    // A save was interrupted, drop the torn frame so appends stay reachable
+    std::error_code error;
+    std::filesystem::resize_file(journal_path, kHeaderSize + *position, error);
+  }
+  return true;
+}
+
+uint64_t Journal::Size(const std::filesystem::path& base_path) {
+  std::error_code error;
+  const auto size = std::filesystem::file_size(PathFor(base_path), error);
+  return error ? 0 : size;
+}
+
+std::optional<JournalMark> Journal::Mark(
+  const std::filesystem::path& base_path) {
+  auto lock = Lock();
+  if (!IsBound(base_path)) {
+    return std::nullopt;
+  }
+  return JournalMark{FingerprintOf(base_path), Size(base_path)};
+}
+
+bool Journal::Rebind(const std::filesystem::path& base_path,
+  const std::filesystem::path& compacted_path, const JournalMark& mark) {
+  auto lock = Lock();
+  std::error_code error;
+  const auto journal_path = PathFor(base_path);
+  if (!IsBound(base_path) || FingerprintOf(base_path) != mark.fingerprint) {
+    std::filesystem::remove(compacted_path, error);
+    return false;
+  }
+
+  const auto tail =
+    ReadBytes(journal_path, mark.length, UINT64_MAX);
+  auto journal_temp_path = journal_path;
+  journal_temp_path += ".tmp";
+  if (!WriteHeader(journal_temp_path, FingerprintOf(compacted_path))) {
+    std::filesystem::remove(compacted_path, error);
+    return false;
+  }
+  {
+    std::ofstream file(journal_temp_path, std::ios::binary | std::ios::app);
+    file.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+  }
+  SyncFile(journal_temp_path);
+  // Base first: if we stop in between, only the frames of the tail are lost
+  std::filesystem::rename(compacted_path, base_path, error);
+  if (error) {
+    std::filesystem::remove(compacted_path, error);
+    std::filesystem::remove(journal_temp_path, error);
+    return false;
+  }
+  std::filesystem::rename(journal_temp_path, journal_path, error);
+  return !error;
+}
+
+void Journal::Remove(const std::filesystem::path& base_path) {
+  auto lock = Lock();
+  std::error_code error;
+  std::filesystem::remove(PathFor(base_path), error);
+}
+
+std::unique_lock<std::recursive_mutex> Journal::Lock() {
+  return std::unique_lock(mutex_);
+}
+
+std::optional<JournalFingerprint> Journal::ReadHeader(
+  const std::filesystem::path& journal_path, uint32_t const min_version) {
+  std::ifstream file(journal_path, std::ios::binary);
+  char header[kHeaderSize];
+  if (!file.is_open() ||
+      !file.read(header, static_cast<std::streamsize>(kHeaderSize)) ||
+      std::memcmp(header, JOURNAL_MAGIC, 8) != 0) {
+    return std::nullopt;
+  }
+  uint32_t version = 0;
+  std::memcpy(&version, header + 8, sizeof(version));
+  if (version < min_version || version > JOURNAL_VERSION) {
+    return std::nullopt;
+  }
+  JournalFingerprint fingerprint;
+  std::memcpy(&fingerprint.size, header + 16, sizeof(fingerprint.size));
+  std::memcpy(&fingerprint.modified, header + 24, sizeof(fingerprint.modified));
+  return fingerprint;
+}
+
+bool Journal::WriteHeader(const std::filesystem::path& journal_path,
+  const JournalFingerprint& fingerprint) {
+  char header[kHeaderSize] = {};
+  const uint32_t version = JOURNAL_VERSION;
+  std::memcpy(header, JOURNAL_MAGIC, 8);
+  std::memcpy(header + 8, &version, sizeof(version));
+  std::memcpy(header + 16, &fingerprint.size, sizeof(fingerprint.size));
+  std::memcpy(header + 24, &fingerprint.modified, sizeof(fingerprint.modified));
+  std::ofstream file(journal_path, std::ios::binary | std::ios::trunc);
+  file.write(header, static_cast<std::streamsize>(kHeaderSize));
+  file.close();
+  return file.good();
+}
+
+}  // namespace linea_one::io
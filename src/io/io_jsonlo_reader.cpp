@@ -0,0 +1,371 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_jsonlo_reader.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_jsonlo_reader.h>
+#include <io/io_mapped_file.h>
+
+#include <cstring>
+#include <iterator>
+#include <nlohmann/json.hpp>
+
+namespace linea_one::io {
+
+namespace {
+
+using json = nlohmann::json;
+
+/* Escaped contents of JSON strings inside a mapped .jsonlo file. */
+class JsonloTextSource final : public TextSource {
+ public:
+  explicit JsonloTextSource(std::shared_ptr<MappedFile> p_file)
+    : p_file_(std::move(p_file)) {}
+
+  void Fetch(const uint64_t offset, const uint64_t length,
+    std::string& text) const override {
+    const auto* p_text = reinterpret_cast<const char*>(p_file_->Data()) + offset;
+    if (std::memchr(p_text, '\\', length) == nullptr) {
+      text.assign(p_text, length);
+      return;
+    }
+    text.assign(1, '"');
+    text.append(p_text, length);
+    text += '"';
+    text = json::parse(text).get<std::string>();
+  }
+
+ private:
+  std::shared_ptr<MappedFile> p_file_;
+};
+
+/* Walks a memory range and publishes how far the lexer has read, so the
+ * handler knows where the current token ends. */
+class CursorIterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = char;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const char*;
+  using reference = const char&;
+
+  CursorIterator(const char* p_position, const char** p_cursor)
+    : p_position_(p_position), p_cursor_(p_cursor) {}
+
+  reference operator*() const { return *p_position_; }
+  CursorIterator& operator++() {
+    *p_cursor_ = ++p_position_;
+    return *this;
+  }
+  CursorIterator operator++(int) {
+    auto previous = *this;
+    ++*this;
+    return previous;
+  }
+  bool operator==(const CursorIterator& other) const {
+    return p_position_ == other.p_position_;
+  }
+
+ private:
+  const char* p_position_;
+  const char** p_cursor_;
+};
+
+/* Where lazily loaded descriptions come from, see JsonloReader::ReadLazy. */
+struct LazyInput {
+  uint32_t source = 0;
+  const char* p_begin = nullptr;
+  const char* p_cursor = nullptr;
+};
+
+enum class Section { kOther, kState, kEvents };
+
+enum class Field {
+  kNone,
+  kName,
+  kZoom,
+  kOffset,
+  kId,
+  kYear,
+  kMonth,
+  kDay,
+  kTime,
+  kHeadline,
+  kDescription,
+  kExpanded
+};
+
+/* Fills the document while nlohmann tokenizes the stream. Only the known
+ * .jsonlo layout is tracked, unknown keys and containers are skipped. */
+class JsonloSaxHandler {
+ public:
+  explicit JsonloSaxHandler(Document& document, LazyInput* p_lazy = nullptr)
+    : document_(document), p_lazy_(p_lazy) {}
+
+  bool null() { return Consumed(); }
+
+  bool boolean(const bool value) {
+    if (skip_depth_ == 0 && field_ == Field::kExpanded) {
+      document_.events.back().expanded = value;
+    }
+    return Consumed();
+  }
+
+  bool number_integer(const json::number_integer_t value) {
+    return Number(value);
+  }
+
+  bool number_unsigned(const json::number_unsigned_t value) {
+    return Number(value);
+  }
+
+  bool number_float(const json::number_float_t value, const json::string_t&) {
+    return Number(value);
+  }
+
+  bool string(json::string_t& value) {
+    if (skip_depth_ == 0) {
+      switch (field_) {
+        // Copied, moving would hand over the capacity the lexer buffer grew
+        // to for the longest string so far. Texts go into the arena.
+        case Field::kName: document_.name = value; break;
+        case Field::kHeadline: document_.events.back().headline = value; break;
+        case Field::kTime:
+          if (const auto second = ParseTimeOfDay(value)) {
+            second_ = *second;
+          } else {
+            return false;
+          }
+          break;
+        case Field::kDescription:
+          if (p_lazy_) {
+            SetLazyText(document_.events.back().description);
+          } else {
+            document_.events.back().description = value;
+          }
+          break;
+        default: break;
+      }
+    }
+    return Consumed();
+  }
+
+  bool binary(json::binary_t&) { return Consumed(); }
+
+  bool start_object(std::size_t) {
+    ++depth_;
+    if (skip_depth_ == 0) {
+      if (depth_ == 3 && section_ == Section::kEvents) {
+        document_.events.emplace_back();
+      } else if (!(depth_ == 1 || (depth_ == 2 && section_ == Section::kState &&
+                                    field_ == Field::kNone))) {
+        skip_depth_ = depth_;
+      }
+    }
+    field_ = Field::kNone;
+    return true;
+  }
+
+  bool end_object() {
+    if (skip_depth_ == 0 && depth_ == 3 && section_ == Section::kEvents &&
+        !SetDate()) {
+      return false;
+    }
+    return EndContainer();
+  }
+
+  bool start_array(std::size_t) {
+    ++depth_;
+    if (skip_depth_ == 0 && !(depth_ == 2 && section_ == Section::kEvents)) {
+      skip_depth_ = depth_;
+    }
+    field_ = Field::kNone;
+    return true;
+  }
+
+  bool end_array() { return EndContainer(); }
+
+  bool key(json::string_t& key) {
+    if (skip_depth_ != 0) {
+      return true;
+    }
+    field_ = Field::kNone;
+    if (depth_ == 1) {
+      section_ = Section::kOther;
+      if (key == "Name") {
+        field_ = Field::kName;
+      } else if (key == "State") {
+        section_ = Section::kState;
+      } else if (key == "Events") {
+        section_ = Section::kEvents;
+      }
+    } else if (depth_ == 2 && section_ == Section::kState) {
+      if (key == "Zoom") {
+        field_ = Field::kZoom;
+      } else if (key == "Offset") {
+        field_ = Field::kOffset;
+      }
+    } else if (depth_ == 3 && section_ == Section::kEvents) {
+      if (key == "Id") {
+        field_ = Field::kId;
+      } else if (key == "Year") {
+        field_ = Field::kYear;
+      } else if (key == "Month") {
+        field_ = Field::kMonth;
+      } else if (key == "Day") {
+        field_ = Field::kDay;
+      } else if (key == "Time") {
+        field_ = Field::kTime;
+      } else if (key == "Headline") {
+        field_ = Field::kHeadline;
+      } else if (key == "Description") {
+        field_ = Field::kDescription;
+        if (p_lazy_) {
+          key_end_ = p_lazy_->p_cursor;
+        }
+      } else if (key == "Expanded") {
+        field_ = Field::kExpanded;
+      }
+    }
+    return true;
+  }
+
+  bool parse_error(
+    std::size_t, const std::string&, const nlohmann::detail::exception&) {
+    return false;
+  }
+
+ private:
+  template <typename T>
+  bool Number(const T value) {
+    if (skip_depth_ == 0) {
+      switch (field_) {
+        case Field::kZoom:
+          document_.state.zoom = static_cast<float>(value);
+          break;
+        case Field::kOffset:
+          document_.state.offset = static_cast<float>(value);
+          break;
+        case Field::kId:
+          document_.events.set_id(
+            document_.events.size() - 1, static_cast<uint64_t>(value));
+          break;
+        case Field::kYear: year_ = static_cast<int>(value); break;
+        case Field::kMonth: month_ = static_cast<int>(value); break;
+        case Field::kDay: day_ = static_cast<int>(value); break;
+        default: break;
+      }
+    }
+    return Consumed();
+  }
+
+  // The value string is the first quote after the key up to the cursor
+  void SetLazyText(TextRef text) const {
+    const char* p_open = key_end_;
+    while (*p_open != '"') {
+      ++p_open;
+    }
+    const auto offset = static_cast<uint64_t>(p_open + 1 - p_lazy_->p_begin);
+    const auto length = static_cast<uint32_t>(p_lazy_->p_cursor - p_open - 2);
+    text.SetLazy(p_lazy_->source, offset, length);
+  }
+
+  // The date fields may come in any order, they are packed once the event
+  // object ends. Files from before months and days only have a year.
+  bool SetDate() {
+    const auto date = EventDate::Make(year_, month_, day_, second_);
+    year_ = 0;
+    month_ = 0;
+    day_ = 0;
+    second_ = -1;
+    if (!date) {
+      return false;
+    }
+    document_.events.back().date = *date;
+    return true;
+  }
+
+  bool EndContainer() {
+    if (skip_depth_ == depth_) {
+      skip_depth_ = 0;
+    }
+    --depth_;
+    field_ = Field::kNone;
+    return true;
+  }
+
+  bool Consumed() {
+    field_ = Field::kNone;
+    return true;
+  }
+
+  Document& document_;
+  LazyInput* p_lazy_;
+  const char* key_end_ = nullptr;
+  Section section_ = Section::kOther;
+  Field field_ = Field::kNone;
+  int32_t depth_ = 0;
+  int32_t skip_depth_ = 0;
+  int year_ = 0;
+  int month_ = 0;
+  int day_ = 0;
+  int second_ = -1;
+};
+
+}  // namespace
+
+std::optional<Document> JsonloReader::Read(
+  std::istream& stream, const std::uintmax_t size_hint) {
+  Document document{};
+  document.saved = true;
+  // Upper bound of the event count, pages past the real size are never touched
+  if (size_hint > 0) {
+    document.events.reserve(size_hint / JSONLO_MIN_EVENT_BYTES);
+    document.events.reserve_text(size_hint);
+  }
+
+  JsonloSaxHandler handler(document);
+  if (!json::sax_parse(stream, &handler)) {
+    return std::nullopt;
+  }
+  return document;
+}
+
+std::optional<Document> JsonloReader::ReadLazy(
+  const std::filesystem::path& path) {
+  auto p_file = MappedFile::Open(path);
+  if (!p_file) {
+    return std::nullopt;
+  }
+  Document document{};
+  document.saved = true;
+  document.events.reserve(p_file->Size() / JSONLO_MIN_EVENT_BYTES);
+
+  const auto* p_begin = reinterpret_cast<const char*>(p_file->Data());
+  LazyInput lazy{
+    document.events.add_text_source(std::make_shared<JsonloTextSource>(p_file)),
+    p_begin, p_begin};
+  JsonloSaxHandler handler(document, &lazy);
+  if (!json::sax_parse(CursorIterator(p_begin, &lazy.p_cursor),
+        CursorIterator(p_begin + p_file->Size(), &lazy.p_cursor), &handler)) {
+    return std::nullopt;
+  }
+  return document;
+}
+
+}  // namespace linea_one::io
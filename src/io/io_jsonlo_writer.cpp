@@ -0,0 +1,198 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_jsonlo_writer.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <config.h>
+#include <io/io_jsonlo_writer.h>
+#include <utf8.h>
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+namespace linea_one::io {
+
+namespace {
+
+enum ByteClass : uint8_t { kPlain = 0, kEscape, kMultiByte };
+
+constexpr std::array<uint8_t, 256> kByteClasses = []() {
+  std::array<uint8_t, 256> classes{};
+  for (int byte = 0; byte < 0x20; ++byte) {
+    classes[byte] = kEscape;
+  }
+  classes['"'] = kEscape;
+  classes['\\'] = kEscape;
+  for (int byte = 0x80; byte < 0x100; ++byte) {
+    classes[byte] = kMultiByte;
+  }
+  return classes;
+}();
+
+class Writer {
+ public:
+  explicit Writer(std::size_t const capacity, std::ostream* p_stream = nullptr)
+    : p_stream_(p_stream) {
+    buffer_.reserve(capacity);
+  }
+
+  void Raw(std::string_view const text) { buffer_.append(text); }
+
+  template <typename T>
+  void Number(T const value) {
+    char digits[32];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, result.ptr);
+  }
+
+  void String(std::string_view const text) {
+    const auto* p_text = reinterpret_cast<const unsigned char*>(text.data());
+    const auto* p_end = p_text + text.size();
+    buffer_ += '"';
+    while (p_text != p_end) {
+      // Copy the longest run that needs no attention in one append
+      const auto* p_run = p_text;
+      while (p_text != p_end && kByteClasses[*p_text] == kPlain) {
+        ++p_text;
+      }
+      buffer_.append(reinterpret_cast<const char*>(p_run), p_text - p_run);
+      if (p_text == p_end) {
+        break;
+      }
+      if (kByteClasses[*p_text] == kEscape) {
+        Escape(*p_text);
+        ++p_text;
+      } else if (const auto length = Utf8Length(p_text, p_end)) {
+        buffer_.append(reinterpret_cast<const char*>(p_text), length);
+        p_text += length;
+      } else {
+        buffer_ += "\xEF\xBF\xBD";
+        ++p_text;
+      }
+    }
+    buffer_ += '"';
+  }
+
+  std::string Take() { return std::move(buffer_); }
+
+  // Hands a full chunk to the stream, a no-op when writing into the buffer
+  void FlushIfFull() {
+    if (p_stream_ && buffer_.size() >= JSONLO_WRITE_CHUNK_BYTES) {
+      Flush();
+    }
+  }
+
+  bool Flush() {
+    p_stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+    return p_stream_->good();
+  }
+
+ private:
+  void Escape(unsigned char const byte) {
+    switch (byte) {
+      case '"': buffer_ += "\\\""; break;
+      case '\\': buffer_ += "\\\\"; break;
+      case '\b': buffer_ += "\\b"; break;
+      case '\f': buffer_ += "\\f"; break;
+      case '\n': buffer_ += "\\n"; break;
+      case '\r': buffer_ += "\\r"; break;
+      case '\t': buffer_ += "\\t"; break;
+      default: {
+        static constexpr char kHex[] = "0123456789abcdef";
+        const char escaped[] = {
+          '\\', 'u', '0', '0', kHex[byte >> 4], kHex[byte & 0x0F]};
+        buffer_.append(escaped, sizeof(escaped));
+      }
+    }
+  }
+
+  std::string buffer_;
+  std::ostream* p_stream_;
+};
+
+void Serialize(Writer& writer, const Document& document) {
+  writer.Raw("{\n  \"Name\": ");
+  writer.String(document.name);
+  writer.Raw(",\n  \"Version\": \"");
+  writer.Number(PROJECT_VERSION_MAJOR);
+  writer.Raw(".");
+  writer.Number(PROJECT_VERSION_MINOR);
+  writer.Raw("\",\n  \"State\": {\n    \"Zoom\": ");
+  writer.Number(document.state.zoom);
+  writer.Raw(",\n    \"Offset\": ");
+  writer.Number(document.state.offset);
+  writer.Raw("\n  },\n  \"Events\": [\n");
+
+  for (std::size_t i = 0; i < document.events.size(); ++i) {
+    const auto& event = document.events[i];
+    writer.Raw("    {\n      \"Id\": ");
+    writer.Number(event.id);
+    writer.Raw(",\n      \"Year\": ");
+    writer.Number(event.date.Year());
+    // Only dates finer than a year have these, older files look the same
+    if (event.date.Month() != 0) {
+      writer.Raw(",\n      \"Month\": ");
+      writer.Number(event.date.Month());
+    }
+    if (event.date.Day() != 0) {
+      writer.Raw(",\n      \"Day\": ");
+      writer.Number(event.date.Day());
+    }
+    if (event.date.HasTime()) {
+      writer.Raw(",\n      \"Time\": ");
+      writer.String(FormatTimeOfDay(event.date.Second()));
+    }
+    writer.Raw(",\n      \"Headline\": ");
+    writer.String(event.headline.str());
+    writer.Raw(",\n      \"Description\": ");
+    writer.String(event.description.str());
+    writer.Raw(",\n      \"Expanded\": ");
+    writer.Raw(event.expanded ? "true" : "false");
+    writer.Raw(i + 1 != document.events.size() ? "\n    },\n" : "\n    }\n");
+    writer.FlushIfFull();
+  }
+  writer.Raw("  ]\n}\n");
+}
+
+}  // namespace
+
+std::size_t JsonloWriter::EstimateSize(const Document& document) {
+  std::size_t size = 256 + document.name.size();
+  for (const auto& event : document.events) {
+    size += JSONLO_EVENT_OVERHEAD_BYTES + event.headline.size() +
+            event.description.size();
+  }
+  return size;
+}
+
+std::string JsonloWriter::Write(const Document& document) {
+  Writer writer(EstimateSize(document));
+  Serialize(writer, document);
+  return writer.Take();
+}
+
+bool JsonloWriter::Write(const Document& document, std::ostream& stream) {
+  Writer writer(JSONLO_WRITE_CHUNK_BYTES + JSONLO_EVENT_OVERHEAD_BYTES, &stream);
+  Serialize(writer, document);
+  return writer.Flush();
+}
+
+}  // namespace linea_one::io
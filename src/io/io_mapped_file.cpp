@@ -0,0 +1,108 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_mapped_file.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_mapped_file.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace linea_one::io {
+
+#if defined(_WIN32) || defined(_WIN64)
+
+std::shared_ptr<MappedFile> MappedFile::Open(
+  const std::filesystem::path& path) {
+  auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+  mapped->file_handle_ = CreateFileW(path.c_str(), GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (mapped->file_handle_ == INVALID_HANDLE_VALUE) {
+    mapped->file_handle_ = nullptr;
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(mapped->file_handle_, &size) || size.QuadPart == 0) {
+    return nullptr;
+  }
+  mapped->mapping_handle_ = CreateFileMappingW(
+    mapped->file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapped->mapping_handle_ == nullptr) {
+    return nullptr;
+  }
+  mapped->p_data_ = static_cast<const std::byte*>(
+    MapViewOfFile(mapped->mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+  if (mapped->p_data_ == nullptr) {
+    return nullptr;
+  }
+  mapped->size_ = static_cast<std::size_t>(size.QuadPart);
+  return mapped;
+}
+
+MappedFile::~MappedFile() {
+  if (p_data_) UnmapViewOfFile(p_data_);
+  if (mapping_handle_) CloseHandle(mapping_handle_);
+  if (file_handle_) CloseHandle(file_handle_);
+}
+
+#else
+
+std::shared_ptr<MappedFile> MappedFile::Open(
+  const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  void* p_data = mmap(nullptr, static_cast<std::size_t>(file_stat.st_size),
+    PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if (p_data == MAP_FAILED) {
+    return nullptr;
+  }
+  auto mapped = std::shared_ptr<MappedFile>(new MappedFile());
+  mapped->p_data_ = static_cast<const std::byte*>(p_data);
+  mapped->size_ = static_cast<std::size_t>(file_stat.st_size);
+  return mapped;
+}
+
+MappedFile::~MappedFile() {
+  if (p_data_) {
+    munmap(const_cast<std::byte*>(p_data_), size_);
+  }
+}
+
+#endif
+
+const std::byte* MappedFile::Data() const { return p_data_; }
+
+std::size_t MappedFile::Size() const { return size_; }
+
+}  // namespace linea_one::io
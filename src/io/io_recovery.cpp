@@ -0,0 +1,206 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_recovery.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <config.h>
+#include <io/io_file_sync.h>
+#include <io/io_journal.h>
+#include <io/io_recovery.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <random>
+
+namespace linea_one::io {
+
+namespace {
+
+struct RecoveryHeader {
+  RecoveredDocument document;
+  uint32_t version = 0;
+  uint64_t frames_offset = 0;
+};
+
+void PutText(std::string& buffer, const std::string& text) {
+  const auto length = static_cast<uint32_t>(text.size());
+  buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  buffer.append(text);
+}
+
+bool GetText(const std::string& bytes, uint64_t& position, std::string& text) {
+  uint32_t length = 0;
+  if (bytes.size() - position < sizeof(length)) {
+    return false;
+  }
+  std::memcpy(&length, bytes.data() + position, sizeof(length));
+  position += sizeof(length);
+  if (bytes.size() - position < length) {
+    return false;
+  }
+  text.assign(bytes.data() + position, length);
+  position += length;
+  return true;
+}
+
+std::string ReadFile(
+  const std::filesystem::path& path, const uint64_t limit = UINT64_MAX) {
+  std::ifstream file(path, std::ios::binary);
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (!file.is_open() || error) {
+    return {};
+  }
+  std::string bytes(std::min<uint64_t>(size, limit), '\0');
+  file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  bytes.resize(static_cast<uint64_t>(file.gcount()));
+  return bytes;
+}
+
+std::optional<RecoveryHeader> ParseHeader(
+  const std::string& bytes, const std::filesystem::path& recovery_path) {
+  uint32_t version = 0;
+  if (bytes.size() < 16 || std::memcmp(bytes.data(), RECOVERY_MAGIC, 8) != 0) {
+    return std::nullopt;
+  }
+  std::memcpy(&version, bytes.data() + 8, sizeof(version));
+  if (version < RECOVERY_MIN_VERSION || version > RECOVERY_VERSION) {
+    return std::nullopt;
+  }
+  RecoveryHeader header;
+  header.version = version;
+  header.document.recovery_path = recovery_path;
+  uint64_t position = 16;
+  std::string source;
+  if (!GetText(bytes, position, source) ||
+      !GetText(bytes, position, header.document.name)) {
+    return std::nullopt;
+  }
+  header.document.source_path = std::filesystem::path(
+    std::u8string(source.begin(), source.end()));
+  header.frames_offset = position;
+  return header;
+}
+
+}  // namespace
+
+std::filesystem::path Recovery::Directory() {
+  std::filesystem::path root;
+#if defined(_WIN32) || defined(_WIN64)
+  if (const char* p_data = std::getenv("LOCALAPPDATA")) {
+    root = p_data;
+  }
+#else
+  if (const char* p_data = std::getenv("XDG_DATA_HOME"); p_data && *p_data) {
+    root = p_data;
+  } else if (const char* p_home = std::getenv("HOME")) {
+    root = std::filesystem::path(p_home) / ".local" / "share";
+  }
+#endif
+  if (root.empty()) {
+    root = std::filesystem::temp_directory_path();
+  }
+  return root / PROJECT_NAME / "recovery";
+}
+
+std::filesystem::path Recovery::NewPath() {
+  std::random_device random;
+  const uint64_t id = (static_cast<uint64_t>(random()) << 32) | random();
+  return Directory() / std::format("{:016x}{}", id, RECOVERY_EXTENSION);
+}
+
+bool Recovery::Start(const std::filesystem::path& recovery_path,
+  const std::filesystem::path& source_path, const std::string& name) {
+  std::error_code error;
+  std::filesystem::create_directories(recovery_path.parent_path(), error);
+
+  std::string header(16, '\0');
+  const uint32_t version = RECOVERY_VERSION;
+  std::memcpy(header.data(), RECOVERY_MAGIC, 8);
+  std::memcpy(header.data() + 8, &version, sizeof(version));
+  const auto source = source_path.u8string();
+  PutText(header, std::string(source.begin(), source.end()));
+  PutText(header, name);
+
+  std::ofstream file(recovery_path, std::ios::binary | std::ios::trunc);
+  file.write(header.data(), static_cast<std::streamsize>(header.size()));
+  file.close();
+  return file.good() && SyncFile(recovery_path);
+}
+
+bool Recovery::Append(
+  const std::filesystem::path& recovery_path, const std::string& frame) {
+  std::ofstream file(recovery_path, std::ios::binary | std::ios::app);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+  file.close();
+  return file.good() && SyncFile(recovery_path);
+}
+
+std::vector<RecoveredDocument> Recovery::List() {
+  std::vector<RecoveredDocument> documents;
+  std::error_code error;
+  for (const auto& entry :
+    std::filesystem::directory_iterator(Directory(), error)) {
+    if (entry.path().extension() != RECOVERY_EXTENSION) {
+      continue;
+    }
+    // Enough for any source path and name, frames are not needed here
+    const auto bytes = ReadFile(entry.path(), 64 * 1024);
+    if (const auto header = ParseHeader(bytes, entry.path())) {
+      documents.push_back(header->document);
+    }
+  }
+  return documents;
+}
+
+bool Recovery::Restore(
+  Document& document, const std::filesystem::path& recovery_path) {
+  const auto bytes = ReadFile(recovery_path);
+  const auto header = ParseHeader(bytes, recovery_path);
+  if (!header) {
+    return false;
+  }
+  if (!Journal::ApplyFrames(document, bytes.data() + header->frames_offset,
+        bytes.size() - header->frames_offset)) {
+    return false;
+  }
+  if (header->version != RECOVERY_VERSION) {
+    const uint32_t version = RECOVERY_VERSION;
+    std::fstream file(recovery_path,
+      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.close();
+    return file.good() && SyncFile(recovery_path);
+  }
+  return true;
+}
+
+void Recovery::Remove(const std::filesystem::path& recovery_path) {
+  std::error_code error;
+  std::filesystem::remove(recovery_path, error);
+}
+
+}  // namespace linea_one::io
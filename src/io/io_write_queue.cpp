@@ -0,0 +1,72 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: io_write_queue.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_write_queue.h>
+
+namespace linea_one::io {
+
+WriteQueue::WriteQueue() : worker_([this]() { Run(); }) {}
+
+WriteQueue::~WriteQueue() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_one();
+  worker_.join();
+}
+
+void WriteQueue::Push(std::function<void()> job) {
+  {
+    std::lock_guard lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  condition_.notify_one();
+}
+
+std::size_t WriteQueue::Pending() {
+  std::lock_guard lock(mutex_);
+  return jobs_.size() + running_;
+}
+
+void WriteQueue::Wait() {
+  std::unique_lock lock(mutex_);
+  idle_.wait(lock, [this]() { return jobs_.empty() && running_ == 0; });
+}
+
+void WriteQueue::Run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+    if (jobs_.empty()) {
+      return;
+    }
+    auto job = std::move(jobs_.front());
+    jobs_.pop_front();
+    running_ = 1;
+    lock.unlock();
+    job();
+    lock.lock();
+    running_ = 0;
+    idle_.notify_all();
+  }
+}
+
+}  // namespace linea_one::io
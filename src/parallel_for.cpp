@@ -0,0 +1,59 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: parallel_for.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace linea_one {
+
+namespace {
+
+std::size_t HardwareThreads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+void ParallelFor(
+  std::size_t const parts, const std::function<void(std::size_t)>& task) {
+  std::atomic<std::size_t> next{0};
+  const auto run = [&] {
+    for (auto part = next++; part < parts; part = next++) {
+      task(part);
+    }
+  };
+  std::vector<std::jthread> helpers;
+  const std::size_t threads = std::min(parts, HardwareThreads());
+  for (std::size_t i = 1; i < threads; ++i) {
+    helpers.emplace_back(run);
+  }
+  run();
+}
+
+std::size_t ParallelParts(std::size_t const count) {
+  return std::clamp<std::size_t>(
+    count / PARALLEL_FOR_MIN_ITEMS, 1, HardwareThreads());
+}
+
+}  // namespace linea_one
@@ -0,0 +1,138 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: text_arena.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <text_arena.h>
+
+#include <functional>
+
+namespace linea_one {
+
+TextHandle TextArena::Intern(std::string_view const text) {
+  if (text.empty()) {
+    return {};
+  }
+  // Appending may move the buffer, a text from inside it is copied first
+  if (!buffer_.empty() && text.data() >= buffer_.data() &&
+      text.data() < buffer_.data() + buffer_.size()) {
+    return Intern(std::string(text));
+  }
+
+  if ((interned_ + 1) * 10 > slots_.size() * 7) {
+    Grow();
+  }
+  const auto hash = static_cast<uint32_t>(std::hash<std::string_view>{}(text));
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t index = hash & mask;
+  for (; slots_[index].offset != kEmptySlot; index = (index + 1) & mask) {
+    const auto& slot = slots_[index];
+    if (slot.hash == hash && Text(slot.offset, slot.length) == text) {
+      return {slot.offset, slot.length, 0};
+    }
+  }
+
+  const auto offset = static_cast<uint64_t>(buffer_.size());
+  const auto length = static_cast<uint32_t>(text.size());
+  buffer_.insert(buffer_.end(), text.begin(), text.end());
+  buffer_.push_back('\0');
+  slots_[index] = {offset, length, hash};
+  ++interned_;
+  return {offset, length, 0};
+}
+
+uint32_t TextArena::AddSource(std::shared_ptr<const TextSource> p_source) {
+  sources_.push_back(std::move(p_source));
+  return static_cast<uint32_t>(sources_.size());
+}
+
+std::string_view TextArena::View(const TextHandle& handle) const {
+  return Text(handle.offset, handle.length);
+}
+
+TextHandle TextArena::Load(const TextHandle& handle) {
+  Fetch(handle, fetched_);
+  return Intern(fetched_);
+}
+
+void TextArena::Fetch(const TextHandle& handle, std::string& text) const {
+  sources_[handle.source - 1]->Fetch(handle.offset, handle.length, text);
+}
+
+void TextArena::Release(const TextHandle& handle) {
+  if (handle.source == 0 && handle.length > 0) {
+    garbage_ += handle.length + 1;
+  }
+}
+
+bool TextArena::NeedsCompaction() const {
+  // Overestimated, a released text may still be shared by another handle
+  return garbage_ >= TEXT_ARENA_COMPACT_MIN_BYTES &&
+         garbage_ * 2 >= buffer_.size();
+}
+
+void TextArena::Compact(std::initializer_list<std::span<TextHandle>> columns) {
+  TextArena compacted;
+  compacted.sources_ = std::move(sources_);
+  std::size_t live = 0;
+  for (const auto column : columns) {
+    for (const auto& handle : column) {
+      live += handle.source == 0 ? handle.length + 1 : 0;
+    }
+  }
+  compacted.Reserve(live);
+  for (const auto column : columns) {
+    for (auto& handle : column) {
+      if (handle.source == 0) {
+        handle = compacted.Intern(Text(handle.offset, handle.length));
+      }
+    }
+  }
+  *this = std::move(compacted);
+}
+
+void TextArena::Reserve(std::size_t const bytes) { buffer_.reserve(bytes); }
+
+void TextArena::Clear() { *this = TextArena(); }
+
+std::size_t TextArena::Size() const { return buffer_.size(); }
+
+std::string_view TextArena::Text(
+  uint64_t const offset, uint32_t const length) const {
+  return length == 0 ? std::string_view()
+                     : std::string_view(buffer_.data() + offset, length);
+}
+
+void TextArena::Grow() {
+  std::vector<Slot> slots(
+    slots_.empty() ? TEXT_ARENA_INITIAL_SLOTS : slots_.size() * 2);
+  const std::size_t mask = slots.size() - 1;
+  for (const auto& slot : slots_) {
+    if (slot.offset == kEmptySlot) {
+      continue;
+    }
+    std::size_t index = slot.hash & mask;
+    while (slots[index].offset != kEmptySlot) {
+      index = (index + 1) & mask;
+    }
+    slots[index] = slot;
+  }
+  slots_ = std::move(slots);
+}
+
+}  // namespace linea_one
@@ -0,0 +1,97 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: text_measure_cache.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <text_measure_cache.h>
+
+#include <format>
+
+namespace linea_one {
+
+TextMeasureCache::TextMeasureCache(TextWidth measure)
+  : measure_(std::move(measure)) {}
+
+void TextMeasureCache::SetFont(uint64_t const font) {
+  if (font != font_) {
+    Clear();
+    font_ = font;
+  }
+}
+
+float TextMeasureCache::Width(std::string_view const text) {
+  if (const auto it = widths_.find(text); it != widths_.end()) {
+    return it->second;
+  }
+  if (widths_.size() >= TEXT_MEASURE_CACHE_MAX_ENTRIES) {
+    widths_.clear();
+  }
+  const float width = measure_(text);
+  widths_.emplace(text, width);
+  return width;
+}
+
+const MeasuredText& TextMeasureCache::DateLabel(EventDate const date) {
+  return DateLabel(date, date);
+}
+
+const MeasuredText& TextMeasureCache::DateLabel(
+  EventDate const first, EventDate const last) {
+  const std::pair key{first.Key(), last.Key()};
+  if (const auto it = labels_.find(key); it != labels_.end()) {
+    return it->second;
+  }
+  return Label(key, first == last
+    ? FormatDate(first)
+    : std::format("{} - {}", FormatDate(first), FormatDate(last)));
+}
+
+const MeasuredText& TextMeasureCache::NumberLabel(uint64_t const number) {
+  if (const auto it = numbers_.find(number); it != numbers_.end()) {
+    return it->second;
+  }
+  if (numbers_.size() >= TEXT_MEASURE_CACHE_MAX_ENTRIES) {
+    numbers_.clear();
+  }
+  std::string text = std::to_string(number);
+  const float width = measure_(text);
+  return numbers_.emplace(number, MeasuredText{std::move(text), width})
+    .first->second;
+}
+
+std::size_t TextMeasureCache::Size() const {
+  return widths_.size() + labels_.size() + numbers_.size();
+}
+
+void TextMeasureCache::Clear() {
+  widths_.clear();
+  labels_.clear();
+  numbers_.clear();
+}
+
+const MeasuredText& TextMeasureCache::Label(
+  std::pair<int64_t, int64_t> const key, std::string text) {
+  if (labels_.size() >= TEXT_MEASURE_CACHE_MAX_ENTRIES) {
+    labels_.clear();
+  }
+  const float width = measure_(text);
+  return labels_.emplace(key, MeasuredText{std::move(text), width})
+    .first->second;
+}
+
+}  // namespace linea_one
@@ -24,16 +24,17 @@
 #include <ui/ui_elements.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <format>
 
 namespace linea_one::ui {
 
 UiDocumentTab::UiDocumentTab(const std::shared_ptr<SDL_Renderer>& p_renderer,
-  std::shared_ptr<DocumentManager> p_doc_man)
+  std::shared_ptr<DocumentManager> p_doc_man,
+  std::shared_ptr<TextMeasureCache> p_text_cache)
   : p_renderer_(p_renderer)
   , p_doc_man_(p_doc_man)
-  , year_(1999)
-  , new_year_(1999) {
+  , p_text_cache_(std::move(p_text_cache)) {
   p_drag_icon_ =
     std::make_shared<svg::SvgIcon>(DRAG_INDICATOR_ICON_PATH, p_renderer.get());
   p_delete_icon_ =
@@ -57,20 +58,22 @@ UiDocumentTab::~UiDocumentTab() {
   if (a_buffer_description_) delete[] a_buffer_description_;
 }
 
-void UiDocumentTab::Render(Document& document, uint64_t index) {
+void UiDocumentTab::Render(Document& document, DocumentHandle const handle) {
+  p_view_ = &View(handle);
+  float& left_panel_width = p_view_->left_panel_width;
   const ImVec2 content_size = ImGui::GetContentRegionAvail();
 
   constexpr float minWidth = MIN_SIZE_LEFT_PANEL;
   const float maxWidth = content_size.x * 0.5f;
-  left_panel_width_ = std::clamp(left_panel_width_, minWidth, maxWidth);
+  left_panel_width = std::clamp(left_panel_width, minWidth, maxWidth);
 
   ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
   ImGui::PushStyleVar(ImGuiStyleVar_ChildBorderSize, 0);
 
   ImGui::BeginChild(
-    "LeftPanel", ImVec2(left_panel_width_, content_size.y), true);
+    "LeftPanel", ImVec2(left_panel_width, content_size.y), true);
 
-  RenderLeftBox(document, index);
+  RenderLeftBox(document, handle);
 
   ImGui::EndChild();
 
@@ -84,8 +87,8 @@ void UiDocumentTab::Render(Document& document, uint64_t index) {
 
   if (ImGui::IsItemActive()) {
     float mousePositionX = ImGui::GetIO().MousePos.x;
-    left_panel_width_ = mousePositionX - ImGui::GetWindowPos().x;
-    left_panel_width_ = std::clamp(left_panel_width_, minWidth, maxWidth);
+    left_panel_width = mousePositionX - ImGui::GetWindowPos().x;
+    left_panel_width = std::clamp(left_panel_width, minWidth, maxWidth);
   }
 
   // Cursor
@@ -101,46 +104,68 @@ void UiDocumentTab::Render(Document& document, uint64_t index) {
 }
 
 void UiDocumentTab::AddNewEvent(Document& document) {
-  document.events.emplace_back(last_id_, new_year_, "", false, "");
-  last_id_++;
-  new_year_++;
+  auto& view = View(p_doc_man_->GetCurrentDocumentHandle());
+  const uint64_t id = document.events.allocate_id();
+  const EventDate date = view.new_year;
+  const auto dates = document.events.dates();
+  const uint64_t position =
+    view.auto_order ? std::ranges::upper_bound(dates, date) - dates.begin()
+                    : document.events.size();
+  document.events.insert(position, TimelineEvent{id, date, "", false, ""});
+  document.changes.MarkEvent(id);
+  if (position + 1 != document.events.size()) {
+    document.changes.MarkOrder();
+  }
+  document.history.RecordInsert(position, document.events[position]);
+  view.new_year++;
   document.saved = false;
   DocumentHasChanged();
 }
 
-void UiDocumentTab::StartSort(Document& document, uint64_t index,
-  const std::function<void(Document& document, uint64_t index)>& callback) {
-  is_sorting_ = true;
-  sorting_thread_ = std::jthread([this, &document, index, callback]() {
-    std::ranges::sort(
-      document.events, [](const TimelineEvent& a, const TimelineEvent& b) {
-        return a.year < b.year;
-      });
-    is_sorting_ = false;
-    if (callback) {
-      callback(document, index);
-    }
+bool UiDocumentTab::IsSorting() {
+  return p_doc_man_->IsSorting(p_doc_man_->GetCurrentDocumentHandle());
+}
+
+void UiDocumentTab::ReleaseClosedViews() {
+  std::erase_if(views_, [this](const auto& entry) {
+    return p_doc_man_->GetDocument(entry.first) == nullptr;
   });
+  if (!p_doc_man_->GetDocument(shown_document_)) {
+    p_view_ = nullptr;
+  }
 }
 
-bool UiDocumentTab::IsSorting() { return is_sorting_; }
+void UiDocumentTab::KeepOrder(Document& document, DocumentHandle const handle) {
+  if (View(handle).auto_order && !document.events.sorted_by_date()) {
+    p_doc_man_->SortDocument(handle);
+  }
+}
 
-void UiDocumentTab::RenderLeftBox(Document& document, uint64_t index) {
+DocumentView& UiDocumentTab::View(DocumentHandle const handle) {
+  return views_[handle];
+}
+
+void UiDocumentTab::RenderLeftBox(
+  Document& document, DocumentHandle const handle) {
   ImVec2 content_size = ImGui::GetContentRegionAvail();
 
   float topPanelHeight = content_size.y - 34.0f;
 
   ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(1.0f, 1.0f, 1.0f, 0.3f));
+  if (handle != shown_document_) {
+    // The list comes back scrolled to where this document left it
+    ImGui::SetNextWindowScroll(ImVec2(-1.0f, p_view_->list_scroll_y));
+    shown_document_ = handle;
+  }
   ImGui::BeginChild(
     "LeftPanelTab", ImVec2(content_size.x, topPanelHeight), false);
   if (document.events.empty()) {
-    document.events.emplace_back(last_id_, new_year_, "", false, "");
-    last_id_++;
-    new_year_++;
-  }
-  for (uint64_t i = 0; i < document.events.size(); ++i) {
-    RenderEventBox(document, document.events[i], i);
+    const uint64_t id = document.events.allocate_id();
+    document.events.emplace_back(id, p_view_->new_year, "", false, "");
+    document.changes.MarkEvent(id);
+    p_view_->new_year++;
   }
+  RenderEventList(document);
 
   if (ImGui::Button("Add", ImVec2(content_size.x, 20))) {
     AddNewEvent(document);
@@ -152,23 +177,97 @@ void UiDocumentTab::RenderLeftBox(Document& document, uint64_t index) {
     ImGui::EndTooltip();
   }
 
+  p_view_->list_scroll_y = ImGui::GetScrollY();
   ImGui::EndChild();
   ImGui::PopStyleColor();
 
-  RenderSort(document, index, content_size);
+  RenderSort(document, handle, content_size);
 }
 
-void UiDocumentTab::RenderRightBox(Document& document) {
-  document.state.minYear = std::numeric_limits<int>::max();
-  document.state.maxYear = std::numeric_limits<int>::min();
-  for (const auto& event : document.events) {
-    document.state.minYear =
-      std::ranges::min(document.state.minYear, event.year);
-    document.state.maxYear =
-      std::ranges::max(document.state.maxYear, event.year);
+void UiDocumentTab::RenderEventList(Document& document) {
+  auto& layout = p_view_->list_layout;
+  const uint64_t revision = document.changes.Revision();
+  if (!layout.IsCurrent(revision, document.events.size(), row_gap_)) {
+    layout.Rebuild(document.events, revision, EVENT_CONTAINER_HEIGHT,
+      EVENT_CONTAINER_HEIGHT_EXPANDED, row_gap_);
+    // E.g. undoing a swap made before auto order was on
+    KeepOrder(document, shown_document_);
+  }
+  const float list_top = ImGui::GetCursorPosY();
+  // Set again by the date field while it is still being dragged
+  const auto held = active_event_;
+  active_event_.reset();
+  const auto render_row = [&](uint64_t const row) {
+    ImGui::SetCursorPosY(list_top + layout.Top(row));
+    const float height = document.events[row].expanded
+                           ? EVENT_CONTAINER_HEIGHT_EXPANDED
+                           : EVENT_CONTAINER_HEIGHT;
+    RenderEventBox(document, document.events[row], row);
+    // Spacing and the separator below a row, the layout follows the style
+    row_gap_ = ImGui::GetCursorPosY() - list_top - layout.Top(row) - height;
+  };
+
+  // Rows out of view are only stepped over
+  const float scroll_y = ImGui::GetScrollY() - list_top;
+  const auto [first, last] =
+    layout.Visible(scroll_y, scroll_y + ImGui::GetWindowHeight());
+  // A row may be deleted while the list is drawn
+  for (uint64_t i = first; i < last && i < document.events.size(); ++i) {
+    render_row(i);
   }
+  // A dragged row or a date being dragged stays submitted, the drag would
+  // end once the row is out of view
+  const auto keep = [&](uint64_t const row) {
+    if ((row < first || row >= last) && row < document.events.size()) {
+      render_row(row);
+    }
+  };
+  if (const ImGuiPayload* payload = ImGui::GetDragDropPayload();
+      payload && payload->IsDataType("EVENT_DND")) {
+    keep(static_cast<uint64_t>(*static_cast<const int*>(payload->Data)));
+  }
+  if (held) {
+    if (const auto found = document.events.find(*held);
+        found != document.events.end()) {
+      keep(found.Index());
+    }
+  }
+  ImGui::SetCursorPosY(list_top + layout.Height());
+
+  // Moved after drawing, the rows above hold positions, not ids
+  if (moved_event_) {
+    Reposition(document, *moved_event_);
+    moved_event_.reset();
+  }
+}
+
+void UiDocumentTab::Reposition(Document& document, uint64_t const id) {
+  const auto found = document.events.find(id);
+  if (found == document.events.end()) {
+    return;
+  }
+  const auto from = found.Index();
+  const auto to = document.events.ordered_position(from);
+  if (from == to) {
+    return;
+  }
+  document.events.move(from, to);
+  document.changes.MarkOrder();
+  document.history.RecordMove(id, document.events[to].date, from, to);
+}
 
-  UiDrawTimeline::Render(document.events, document.state);
+void UiDocumentTab::RenderRightBox(Document& document) {
+  std::tie(document.state.minYear, document.state.maxYear) =
+    document.events.year_range();
+
+  auto& bins = p_view_->timeline_bins;
+  if (const uint64_t revision = document.changes.Revision();
+      !bins.IsCurrent(revision, document.events.size())) {
+    bins.Rebuild(document.events, revision);
+  }
+  p_text_cache_->SetFont(elements::FontKey());
+  UiDrawTimeline::Render(
+    document.events, document.state, bins, *p_text_cache_);
 
   auto window_size = ImGui::GetWindowSize();
   auto info_text = std::format("zoom: {}\noffset: {}", document.state.zoom,
@@ -190,7 +289,7 @@ void UiDocumentTab::RenderRightBox(Document& document) {
 }
 
 void UiDocumentTab::RenderEventBox(
-  Document& document, TimelineEvent& event, uint64_t order) {
+  Document& document, EventRef event, uint64_t order) {
   const ImVec2 content_size = ImGui::GetContentRegionAvail();
   const float container_height =
     event.expanded ? EVENT_CONTAINER_HEIGHT_EXPANDED : EVENT_CONTAINER_HEIGHT;
@@ -218,17 +317,19 @@ void UiDocumentTab::RenderEventBox(
   ImGui::InvisibleButton(
     "##DragHandle", ImVec2(ICON_SIZE + ICON_PADDING * 2, container_height));
 
-  if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_None)) {
+  // Auto order decides the position, rows can not be dragged
+  if (!p_view_->auto_order &&
+      ImGui::BeginDragDropSource(ImGuiDragDropFlags_None)) {
     ImGui::SetDragDropPayload("EVENT_DND", &order, sizeof(int));
 
-    std::string formatted_text = std::format("Moving Event {}{}", event.year,
-      event.headline.empty() ? "" : std::format(", {}", event.headline));
+    std::string formatted_text = std::format("Moving Event {}{}", FormatDate(event.date),
+      event.headline.empty() ? "" : std::format(", {}", event.headline.str()));
     ImGui::Text("%s", formatted_text.c_str());
 
     ImGui::EndDragDropSource();
   }
 
-  if (ImGui::BeginDragDropTarget()) {
+  if (!p_view_->auto_order && ImGui::BeginDragDropTarget()) {
     if (const ImGuiPayload* payload =
           ImGui::AcceptDragDropPayload("EVENT_DND")) {
       int source_order = *(const int*)payload->Data;
@@ -297,7 +398,7 @@ void UiDocumentTab::RenderEventBox(
 }
 
 void UiDocumentTab::RenderExpanderButton(
-  TimelineEvent& event, float width, float height) {
+  EventRef event, float width, float height) {
   auto icon = event.expanded ? p_arrow_drop_up_icon_ : p_arrow_drop_down_icon_;
   auto icon_pos =
     event.expanded
@@ -307,36 +408,67 @@ void UiDocumentTab::RenderExpanderButton(
   if (elements::RenderIconButton(name, icon, 3, ICON_SIZE, ICON_SIZE, icon_pos,
         0, 20, width - 16, ImVec2(0, height - 28))) {
     event.expanded = !event.expanded;
-    DocumentHasChanged();
+    History().RecordExpanded(event.id);
+    EventHasChanged(event);
   }
 }
 
-void UiDocumentTab::RenderDateInput(TimelineEvent& event, const float width) {
+void UiDocumentTab::RenderDateInput(EventRef event, const float width) {
   ImGui::Text("Date");
   ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 4));
   ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 4));
-  ImGui::SetNextItemWidth(width - 72);
-  year_ = event.year;
-  if (year_ < 0) {
-    year_ *= -1;
-  }
+  ImGui::SetNextItemWidth(width - 156);
+  const EventDate before = event.date;
+  int year = std::abs(before.Year());
   if (ImGui::DragInt(
-        "##Date", &year_, 1, 0, 100000, "%d", ImGuiSliderFlags_AlwaysClamp)) {
-    event.year = year_;
-    ParseYear(event, index_bc_ac_);
-    DocumentHasChanged();
+        "##Date", &year, 1, 0, 100000, "%d", ImGuiSliderFlags_AlwaysClamp)) {
+    event.date = before.WithYear(year);
+    ParseYear(event, p_view_->index_bc_ac);
+    History().RecordDate(event.id, before, event.date);
+    DateHasChanged(event);
+  }
+  if (ImGui::IsItemActive()) active_event_ = event.id;
+  if (ImGui::IsItemDeactivated()) History().Seal();
+  if (ImGui::IsItemHovered()) ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+  // Zero leaves the month or the day out
+  ImGui::SameLine(width - 144, 0);
+  ImGui::SetNextItemWidth(40);
+  int month = before.Month();
+  if (ImGui::DragInt("##Month", &month, 0.1f, 0, 12,
+        month == 0 ? "MM" : "%02d", ImGuiSliderFlags_AlwaysClamp)) {
+    event.date = before.WithMonth(month);
+    History().RecordDate(event.id, before, event.date);
+    DateHasChanged(event);
+  }
+  if (ImGui::IsItemActive()) active_event_ = event.id;
+  if (ImGui::IsItemDeactivated()) History().Seal();
+  if (ImGui::IsItemHovered()) ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+  ImGui::SameLine(width - 102, 0);
+  ImGui::SetNextItemWidth(40);
+  int day = before.Day();
+  if (ImGui::DragInt("##Day", &day, 0.2f, 0, 31, day == 0 ? "DD" : "%02d",
+        ImGuiSliderFlags_AlwaysClamp)) {
+    event.date = before.WithDay(day);
+    History().RecordDate(event.id, before, event.date);
+    DateHasChanged(event);
   }
+  if (ImGui::IsItemActive()) active_event_ = event.id;
+  if (ImGui::IsItemDeactivated()) History().Seal();
   if (ImGui::IsItemHovered()) ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
   ImGui::SameLine(width - 60, 0);
   ImGui::SetNextItemWidth(45);
   if (ImGui::BeginCombo(std::format("##BC_AC_{}", event.id).c_str(),
-        bc_ac_items_[index_bc_ac_], ImGuiComboFlags_NoArrowButton)) {
+        bc_ac_items_[p_view_->index_bc_ac], ImGuiComboFlags_NoArrowButton)) {
     for (int n = 0; n < IM_ARRAYSIZE(bc_ac_items_); n++) {
-      const bool is_selected = (index_bc_ac_ == n);
+      const bool is_selected = (p_view_->index_bc_ac == n);
       if (ImGui::Selectable(bc_ac_items_[n], is_selected)) {
-        index_bc_ac_ = n;
-        ParseYear(event, index_bc_ac_);
-        DocumentHasChanged();
+        p_view_->index_bc_ac = n;
+        ParseYear(event, p_view_->index_bc_ac);
+        if (const EventDate after = event.date; after != before) {
+          History().RecordDate(event.id, before, after);
+          History().Seal();
+        }
+        DateHasChanged(event);
       }
 
       if (is_selected) {
@@ -350,7 +482,7 @@ void UiDocumentTab::RenderDateInput(TimelineEvent& event, const float width) {
 }
 
 void UiDocumentTab::RenderHeadlineInput(
-  TimelineEvent& event, const float width) {
+  EventRef event, const float width) {
   ImGui::Text("Headline");
   ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 4));
   ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 4));
@@ -358,14 +490,17 @@ void UiDocumentTab::RenderHeadlineInput(
   strncpy(a_buffer_headline_, event.headline.c_str(), BUFFER_HEADLINE_SIZE);
   if (ImGui::InputText(std::format("##HeadlineInput_{}", event.id).c_str(),
         a_buffer_headline_, BUFFER_HEADLINE_SIZE)) {
-    event.headline = std::string(a_buffer_headline_);
-    DocumentHasChanged();
+    History().RecordText(event.id, TextField::kHeadline, event.headline.str(),
+      a_buffer_headline_);
+    event.headline = a_buffer_headline_;
+    EventHasChanged(event);
   }
+  if (ImGui::IsItemDeactivated()) History().Seal();
   ImGui::PopStyleVar(2);
 }
 
 void UiDocumentTab::RenderDescriptionInput(
-  TimelineEvent& event, float width, uint64_t order) {
+  EventRef event, float width, uint64_t order) {
   ImGui::Text("Description");
   ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 4));
   ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 4));
@@ -375,27 +510,30 @@ void UiDocumentTab::RenderDescriptionInput(
   a_buffer_description_[BUFFER_DESCRIPTION_SIZE - 1] = '\0';
   if (ImGui::InputText(std::format("##DescriptionInput_{}", event.id).c_str(),
         a_buffer_description_, BUFFER_DESCRIPTION_SIZE)) {
-    event.description = std::string(a_buffer_description_);
-    DocumentHasChanged();
+    History().RecordText(event.id, TextField::kDescription,
+      event.description.str(), a_buffer_description_);
+    event.description = a_buffer_description_;
+    EventHasChanged(event);
   }
+  if (ImGui::IsItemDeactivated()) History().Seal();
   ImGui::PopStyleVar(2);
 }
 
-void UiDocumentTab::ParseYear(TimelineEvent& event, uint64_t index) {
-  if (event.year < 0 && index == kAC) {
-    event.year = -event.year;
-  }
-  if (event.year > 0 && index == kBC) {
-    event.year = -event.year;
+void UiDocumentTab::ParseYear(EventRef event, uint64_t index) {
+  const EventDate date = event.date;
+  if ((date.Year() < 0 && index == kAC) || (date.Year() > 0 && index == kBC)) {
+    event.date = date.WithYear(-date.Year());
   }
 }
 
-void UiDocumentTab::DeleteEvent(Document& doc, const TimelineEvent& event) {
-  for (uint64_t i = 0; i < doc.events.size(); ++i) {
-    if (doc.events[i].id == event.id) {
-      doc.events.erase(doc.events.begin() + i);
-      DocumentHasChanged();
-    }
+void UiDocumentTab::DeleteEvent(Document& doc, EventRef event) {
+  const uint64_t id = event.id;
+  if (auto found = doc.events.find(id); found != doc.events.end()) {
+    doc.history.RecordDelete(
+      found.Index(), static_cast<TimelineEvent>(*found));
+    doc.events.erase(found.Index());
+    doc.changes.MarkDeleted(id);
+    DocumentHasChanged();
   }
 }
 
@@ -404,23 +542,26 @@ void UiDocumentTab::SwapEvents(
   if (source_index != target_index && source_index >= 0 &&
       source_index < document.events.size() && target_index >= 0 &&
       target_index < document.events.size()) {
-    std::swap(document.events[source_index], document.events[target_index]);
+    document.events.swap(source_index, target_index);
+    document.changes.MarkOrder();
+    document.history.RecordSwap(source_index, target_index);
     DocumentHasChanged();
   }
 }
 
 void UiDocumentTab::RenderSort(
-  Document& document, uint64_t index, ImVec2 content_size) {
+  Document& document, DocumentHandle const handle, ImVec2 content_size) {
   ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(1.0f, 1.0f, 1.0f, 0.3f));
   ImGui::BeginChild("LeftPanelSort", ImVec2(content_size.x, 30.0f), false);
+  // Keeps every edited, added or deleted event where it sorts
+  if (ImGui::Checkbox("Auto order", &p_view_->auto_order)) {
+    KeepOrder(document, handle);
+  }
+  ImGui::SameLine();
   if (ImVec2 content_size_button = ImGui::GetContentRegionAvail();
       ImGui::Button(
         "Sort", ImVec2(content_size_button.x, content_size_button.y))) {
-    StartSort(document, index,
-      [this](Document& document_document, uint64_t index_index) {
-        p_doc_man_->SetDocOnIndex(document_document, index_index);
-        DocumentHasChanged();
-      });
+    p_doc_man_->SortDocument(handle);
   }
 
   if (ImGui::IsItemHovered(
@@ -431,15 +572,22 @@ void UiDocumentTab::RenderSort(
   }
   ImGui::EndChild();
   ImGui::PopStyleColor();
-  if (is_sorting_) {
+  if (IsSorting()) {
     ImGui::SetCursorPos(ImVec2(0, 0));
     ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.0f, 0.0f, 0.0f, 0.7f));
     ImGui::BeginChild(
       "RightPanelSort", content_size, false);  // Použijte ImVec2 přímo
     ImGui::SetCursorPos(
       ImVec2(content_size.x / 2 - 20, content_size.y / 2 - 20));
+    const auto progress = p_doc_man_->GetSortProgress(handle).value_or(0.0f);
+    const std::string sorting =
+      std::format("Sorting... {}%", static_cast<int>(progress * 100.0f));
     elements::RenderSpinner(
-      "##sorting_screen", "Sorting...", 20, 4, 4.5f, 0.75f);
+      "##sorting_screen", sorting.c_str(), 20, 4, 4.5f, 0.75f);
+    ImGui::SetCursorPosX(content_size.x / 2 - 40);
+    if (ImGui::Button("Cancel", ImVec2(80, 0))) {
+      p_doc_man_->CancelSort(handle);
+    }
     ImGui::EndChild();
     ImGui::PopStyleColor();
   }
@@ -449,5 +597,21 @@ void UiDocumentTab::DocumentHasChanged(){
   p_doc_man_->GetCurrentDocument()->saved = false;
 }
 
+DocumentHistory& UiDocumentTab::History() {
+  return p_doc_man_->GetCurrentDocument()->history;
+}
+
+void UiDocumentTab::EventHasChanged(EventRef event) {
+  p_doc_man_->GetCurrentDocument()->changes.MarkEvent(event.id);
+  DocumentHasChanged();
+}
+
+void UiDocumentTab::DateHasChanged(EventRef event) {
+  if (p_view_->auto_order) {
+    moved_event_ = event.id;
+  }
+  EventHasChanged(event);
+}
+
 
 }  // namespace linea_one::ui
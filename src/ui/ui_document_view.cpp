@@ -0,0 +1,122 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: ui_document_view.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <ui/ui_document_view.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace linea_one::ui {
+
+bool EventListLayout::IsCurrent(
+  uint64_t const revision, std::size_t const rows, float const gap) const {
+  return revision_ == revision && tops_.size() == rows + 1 && gap_ == gap;
+}
+
+void EventListLayout::Rebuild(const EventStore& events,
+  uint64_t const revision, float const collapsed_height,
+  float const expanded_height, float const gap) {
+  const auto flags = events.flags();
+  tops_.resize(flags.size() + 1);
+  tops_[0] = 0.0f;
+  for (std::size_t i = 0; i < flags.size(); ++i) {
+    const float height = (flags[i] & EVENT_FLAG_EXPANDED) != 0
+                           ? expanded_height
+                           : collapsed_height;
+    tops_[i + 1] = tops_[i] + height + gap;
+  }
+  revision_ = revision;
+  gap_ = gap;
+}
+
+std::pair<std::size_t, std::size_t> EventListLayout::Visible(
+  float const top, float const bottom) const {
+  if (tops_.size() < 2) {
+    return {0, 0};
+  }
+  const std::size_t rows = tops_.size() - 1;
+  // The first row ending below top, up to the first one starting at bottom
+  const auto first = static_cast<std::size_t>(
+    std::upper_bound(tops_.begin() + 1, tops_.end(), top) - tops_.begin() - 1);
+  if (first >= rows) {
+    return {rows, rows};
+  }
+  const auto last = static_cast<std::size_t>(
+    std::lower_bound(tops_.begin() + first, tops_.end() - 1, bottom) -
+    tops_.begin());
+  return {first, last};
+}
+
+float EventListLayout::Top(std::size_t const row) const { return tops_[row]; }
+
+float EventListLayout::Height() const {
+  return tops_.empty() ? 0.0f : tops_.back();
+}
+
+bool TimelineBins::IsCurrent(
+  uint64_t const revision, std::size_t const events) const {
+  return built_ && revision_ == revision && events_ == events;
+}
+
+void TimelineBins::Rebuild(const EventStore& events, uint64_t const revision) {
+  for (auto& bins : levels_) {
+    bins.clear();
+  }
+  // Years come in order, so every level is appended in key order
+  for (const auto& [year, positions] : events.year_groups()) {
+    for (int level = 0; level < TIMELINE_BIN_LEVELS; ++level) {
+      auto& bins = levels_[level];
+      const int key = year >> (level * TIMELINE_BIN_LEVEL_BITS);
+      if (bins.empty() || bins.back().key != key) {
+        bins.push_back({key, year, year, 0, positions.front(), 0.0});
+      }
+      auto& bin = bins.back();
+      bin.last_year = year;
+      bin.count += static_cast<uint32_t>(positions.size());
+      bin.year_sum += static_cast<double>(year) * positions.size();
+    }
+  }
+  revision_ = revision;
+  events_ = events.size();
+  built_ = true;
+}
+
+int TimelineBins::Level(float const year_width, float const spacing) {
+  if (!(year_width < spacing)) {
+    return 0;
+  }
+  const float levels =
+    std::log2(spacing / year_width) / TIMELINE_BIN_LEVEL_BITS;
+  return std::clamp(
+    static_cast<int>(std::ceil(levels)), 0, TIMELINE_BIN_LEVELS - 1);
+}
+
+std::span<const TimelineBins::Bin> TimelineBins::Between(
+  int const level, int const first_year, int const last_year) const {
+  const auto& bins = levels_[level];
+  const int shift = level * TIMELINE_BIN_LEVEL_BITS;
+  const auto first = std::ranges::lower_bound(
+    bins, first_year >> shift, {}, &Bin::key);
+  const auto last = std::ranges::upper_bound(
+    first, bins.end(), last_year >> shift, {}, &Bin::key);
+  return {first, last};
+}
+
+}  // namespace linea_one::ui
@@ -22,18 +22,21 @@
 #include <ui/ui_draw_timeline.h>
 
 #include <algorithm>
-#include <format>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace linea_one::ui {
 
-void UiDrawTimeline::Render(
-  const std::vector<TimelineEvent>& events, TimelineState& state) {
+void UiDrawTimeline::Render(const EventStore& events, TimelineState& state,
+  const TimelineBins& bins, TextMeasureCache& text_cache) {
   HandleInteraction(state, events.size());
-  DrawTimeline(events, state);
+  DrawTimeline(events, state, bins, text_cache);
 }
 
-void UiDrawTimeline::DrawTimeline(
-  const std::vector<TimelineEvent>& events, TimelineState& state) {
+void UiDrawTimeline::DrawTimeline(const EventStore& events,
+  TimelineState& state, const TimelineBins& bins,
+  TextMeasureCache& text_cache) {
   ImDrawList* draw_list = ImGui::GetWindowDrawList();
   ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
   ImVec2 canvas_size = ImGui::GetContentRegionAvail();
@@ -54,16 +57,15 @@ void UiDrawTimeline::DrawTimeline(
     // Draw point
     draw_list->AddCircleFilled(center, 5.0f, IM_COL32(0, 120, 250, 255));
 
-    // Draw year
-    std::string year_str = std::to_string(event.year);
-    ImVec2 year_text_size = ImGui::CalcTextSize(year_str.c_str());
-    ImVec2 year_pos(center.x - year_text_size.x / 2, center.y + 10);
+    // Draw date
+    const auto& year_label = text_cache.DateLabel(event.date);
+    ImVec2 year_pos(center.x - year_label.width / 2, center.y + 10);
     draw_list->AddText(
-      year_pos, IM_COL32(200, 200, 200, 255), year_str.c_str());
+      year_pos, IM_COL32(200, 200, 200, 255), year_label.text.c_str());
 
     // Draw headline
-    ImVec2 headline_text_size = ImGui::CalcTextSize(event.headline.c_str());
-    ImVec2 headline_pos(center.x - headline_text_size.x / 2, center.y - 25);
+    const float headline_width = text_cache.Width(event.headline);
+    ImVec2 headline_pos(center.x - headline_width / 2, center.y - 25);
     draw_list->AddText(
       headline_pos, IM_COL32(255, 255, 255, 255), event.headline.c_str());
   } else {
@@ -71,35 +73,164 @@ void UiDrawTimeline::DrawTimeline(
     ImVec2 end(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y / 2);
     draw_list->AddLine(start, end, IM_COL32(255, 255, 255, 255), 2.0f);
 
-    for (const auto& event : events) {
-      float x = MapYearToPixel(event.year, state, canvas_pos.x, canvas_size.x);
-
-      // Skip events outside the visible area
-      if (x < canvas_pos.x - 50 || x > canvas_pos.x + canvas_size.x + 50) {
-        continue;
+    // Only the years inside the visible area are looked up in the index
+    int first_year = state.minYear;
+    int last_year = state.maxYear;
+    float left = -std::numeric_limits<float>::infinity();
+    float right = std::numeric_limits<float>::infinity();
+    if (state.maxYear > state.minYear) {
+      left = MapPixelToYear(
+        canvas_pos.x - 50, state, canvas_pos.x, canvas_size.x);
+      right = MapPixelToYear(
+        canvas_pos.x + canvas_size.x + 50, state, canvas_pos.x, canvas_size.x);
+      // Clamped one year past the ends, a far away view stays in int range
+      // and still finds nothing
+      const float min_year = static_cast<float>(state.minYear) - 1;
+      const float max_year = static_cast<float>(state.maxYear) + 1;
+      first_year = static_cast<int>(std::clamp(std::floor(left), min_year, max_year));
+      last_year = static_cast<int>(std::clamp(std::ceil(right), min_year, max_year));
+    }
+    // Zoomed in far enough, months and days get their own place on the axis
+    const float year_width =
+      MapYearToPixel(state.minYear + 1, state, canvas_pos.x, canvas_size.x) -
+      MapYearToPixel(state.minYear, state, canvas_pos.x, canvas_size.x);
+    const bool fine = year_width >= TIMELINE_FINE_YEAR_WIDTH;
+    // Labels and widths come from the cache, unchanged events are not
+    // formatted or measured again
+    const auto draw_event = [&](uint64_t const position) {
+      const auto event = events[position];
+      float x;
+      EventDate date = event.date;
+      if (fine) {
+        x = MapYearToPixel(date.Years(), state, canvas_pos.x, canvas_size.x);
+      } else {
+        date = EventDate(date.Year());
+        x = MapYearToPixel(date.Year(), state, canvas_pos.x, canvas_size.x);
       }
+      const auto& label = text_cache.DateLabel(date);
 
       ImVec2 point_pos(x, canvas_pos.y + canvas_size.y / 2);
 
       // Draw point
       draw_list->AddCircleFilled(point_pos, 5.0f, IM_COL32(0, 120, 250, 255));
 
-      // Draw year
-      ImVec2 year_text_pos(x - 10, point_pos.y + 10);
+      // Draw date
+      ImVec2 year_text_pos(x - label.width / 2, point_pos.y + 10);
       if (year_text_pos.x >= canvas_pos.x &&
-          year_text_pos.x + 20 <= canvas_pos.x + canvas_size.x) {
-        draw_list->AddText(year_text_pos, IM_COL32(200, 200, 200, 255),
-          std::to_string(event.year).c_str());
+          year_text_pos.x + label.width <= canvas_pos.x + canvas_size.x) {
+        draw_list->AddText(
+          year_text_pos, IM_COL32(200, 200, 200, 255), label.text.c_str());
       }
 
       // Draw headline
-      ImVec2 text_size = ImGui::CalcTextSize(event.headline.c_str());
-      ImVec2 headline_text_pos(x - text_size.x / 2, point_pos.y - 25);
+      const float headline_width = text_cache.Width(event.headline);
+      ImVec2 headline_text_pos(x - headline_width / 2, point_pos.y - 25);
       if (headline_text_pos.x >= canvas_pos.x &&
-          headline_text_pos.x + text_size.x <= canvas_pos.x + canvas_size.x) {
+          headline_text_pos.x + headline_width <= canvas_pos.x + canvas_size.x) {
         draw_list->AddText(headline_text_pos, IM_COL32(255, 255, 255, 255),
           event.headline.c_str());
       }
+    };
+    // One marker for several events, with their count above it
+    const auto draw_cluster = [&](float const x, uint32_t const count,
+                                EventDate const first, EventDate const last) {
+      ImVec2 point_pos(x, canvas_pos.y + canvas_size.y / 2);
+      const float radius =
+        std::min(5.0f + std::log2(static_cast<float>(count)),
+          TIMELINE_CLUSTER_SPACING / 2 - 2);
+      draw_list->AddCircleFilled(point_pos, radius, IM_COL32(0, 120, 250, 255));
+
+      const auto& count_label = text_cache.NumberLabel(count);
+      draw_list->AddText(
+        ImVec2(x - count_label.width / 2, point_pos.y - radius - 20),
+        IM_COL32(255, 255, 255, 255), count_label.text.c_str());
+
+      const auto& label = text_cache.DateLabel(first, last);
+      ImVec2 label_pos(x - label.width / 2, point_pos.y + radius + 5);
+      if (label_pos.x >= canvas_pos.x &&
+          label_pos.x + label.width <= canvas_pos.x + canvas_size.x) {
+        draw_list->AddText(
+          label_pos, IM_COL32(200, 200, 200, 255), label.text.c_str());
+      }
+    };
+    if (!fine) {
+      // Bins at least TIMELINE_CLUSTER_SPACING apart, the coarser the
+      // further out, so the markers are bounded by the canvas width
+      const int level = TimelineBins::Level(year_width, TIMELINE_CLUSTER_SPACING);
+      for (const auto& bin : bins.Between(level, first_year, last_year)) {
+        if (bin.count == 1) {
+          draw_event(bin.position);
+          continue;
+        }
+        draw_cluster(
+          MapYearToPixel(bin.year_sum / bin.count, state, canvas_pos.x, canvas_size.x),
+          bin.count, EventDate(bin.first_year), EventDate(bin.last_year));
+      }
+    } else {
+      // Placed by date, events sharing a cell of the canvas are drawn as
+      // one marker in its middle. Cells are fixed in time, panning does not
+      // regroup them.
+      const double cell_years = TIMELINE_CLUSTER_SPACING / year_width;
+      const auto cell_of = [cell_years](EventDate const date) {
+        return std::floor(date.Years() / cell_years);
+      };
+      const auto draw_cell = [&](double const cell, uint32_t const count,
+                               uint64_t const position, EventDate const first) {
+        if (count == 1) {
+          draw_event(position);
+          return;
+        }
+        draw_cluster(MapYearToPixel((cell + 0.5) * cell_years, state,
+                       canvas_pos.x, canvas_size.x),
+          count, first, first);
+      };
+      if (events.sorted_by_date()) {
+        // The visible events are one run of the date column, found by
+        // binary search like each cell inside it, nothing off screen or
+        // inside a cell is visited
+        const auto dates = events.dates();
+        const auto [begin, end] = events.sorted_between(left, right);
+        auto it = dates.begin() + begin;
+        const auto last = dates.begin() + end;
+        while (it != last) {
+          const double cell = cell_of(*it);
+          const auto next = std::ranges::upper_bound(it, last, cell, {}, cell_of);
+          draw_cell(cell, static_cast<uint32_t>(next - it), it - dates.begin(), *it);
+          it = next;
+        }
+      } else {
+        struct Cell {
+          uint32_t count = 0;
+          uint64_t position = 0;
+          EventDate first;
+        };
+        const double first_cell = std::floor(left / cell_years);
+        std::vector<Cell> cells(
+          static_cast<std::size_t>(std::floor(right / cell_years) - first_cell) + 1);
+        for (const auto& [year, positions] :
+          events.years_between(first_year, last_year)) {
+          for (const auto position : positions) {
+            // Years at the edges are only partly on screen
+            const EventDate date = events.dates()[position];
+            const double years = date.Years();
+            if (years < left || years > right) {
+              continue;
+            }
+            auto& cell = cells[static_cast<std::size_t>(std::clamp(
+              cell_of(date) - first_cell, 0.0, cells.size() - 1.0))];
+            if (cell.count++ == 0 || date < cell.first) {
+              cell.position = position;
+              cell.first = date;
+            }
+          }
+        }
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+          if (cells[i].count > 0) {
+            draw_cell(first_cell + i, cells[i].count, cells[i].position,
+              cells[i].first);
+          }
+        }
+      }
     }
   }
   // Draw main axis
@@ -109,12 +240,19 @@ void UiDrawTimeline::DrawTimeline(
 }
 
 float UiDrawTimeline::MapYearToPixel(
-  int year, const TimelineState& state, float startX, float width) {
+  double year, const TimelineState& state, float startX, float width) {
   float yearRange = state.maxYear - state.minYear;
   float normalizedYear = (year - state.minYear) / yearRange;
   return startX + (normalizedYear * width * (state.zoom*0.8)) + state.offset + 85;
 }
 
+float UiDrawTimeline::MapPixelToYear(
+  float x, const TimelineState& state, float startX, float width) {
+  float yearRange = state.maxYear - state.minYear;
+  float normalizedX = (x - startX - state.offset - 85) / (width * (state.zoom*0.8));
+  return state.minYear + normalizedX * yearRange;
+}
+
 void UiDrawTimeline::HandleInteraction(TimelineState& state, uint64_t events_size) {
   if (events_size <= 1) {
     return; // No interaction for single or no events
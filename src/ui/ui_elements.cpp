@@ -22,6 +22,7 @@
 
 #include <imgui_internal.h>
 
+#include <bit>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -121,7 +122,17 @@ void RenderSpinner(
   } else {
     ImGui::SetCursorPos(ImVec2(pos.x - radius / 2 , pos.y + thickness+2));
   }
-  ImGui::Text(display_text);
+  ImGui::TextUnformatted(display_text);
+}
+
+float MeasureText(std::string_view const text) {
+  return ImGui::CalcTextSize(text.data(), text.data() + text.size()).x;
+}
+
+uint64_t FontKey() {
+  const auto font = reinterpret_cast<std::uintptr_t>(ImGui::GetFont());
+  const auto size = std::bit_cast<uint32_t>(ImGui::GetFontSize());
+  return static_cast<uint64_t>(font) * 31 ^ size;
 }
 
 }  // namespace linea_one::ui::elements
\ No newline at end of file
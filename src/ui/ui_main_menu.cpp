@@ -37,7 +37,7 @@ void UiMainMenu::Render() {
       }
       if (ImGui::MenuItem("Save")) {
 
-        if (p_doc_man_->GetCurrentDocumentIndex() >= 0 &&
+        if (p_doc_man_->GetCurrentDocument() &&
           p_doc_man_->GetCurrentDocument()->path.empty()) {
           SaveFileDialog();
         } else {
@@ -53,11 +53,32 @@ void UiMainMenu::Render() {
       if (ImGui::MenuItem("Export")) {
         ExportFileDialog();
       }
+      if (bool journal_mode = p_doc_man_->GetJournalMode();
+          ImGui::MenuItem("Journal saves", nullptr, &journal_mode)) {
+        p_doc_man_->SetJournalMode(journal_mode);
+      }
+      if (int seconds =
+            static_cast<int>(p_doc_man_->GetAutosaveInterval().count());
+          ImGui::SliderInt("Autosave", &seconds, 0, 600,
+            seconds == 0 ? "off" : "every %d s")) {
+        p_doc_man_->SetAutosaveInterval(std::chrono::seconds(seconds));
+      }
       if (ImGui::MenuItem("Exit")) {
         stop_rendering_ = true;
       }
       ImGui::EndMenu();
     }
+    if (ImGui::BeginMenu("Edit")) {
+      if (ImGui::MenuItem("Undo", "Ctrl+Z", false,
+            edit_enabled_ && p_doc_man_->CanUndo())) {
+        p_doc_man_->Undo();
+      }
+      if (ImGui::MenuItem("Redo", "Ctrl+Y", false,
+            edit_enabled_ && p_doc_man_->CanRedo())) {
+        p_doc_man_->Redo();
+      }
+      ImGui::EndMenu();
+    }
     ImGui::EndMenuBar();
   }
 }
@@ -85,17 +106,21 @@ void UiMainMenu::SetShowExportDialog(const bool show_export_dialog) {
   show_export_dialog_ = show_export_dialog;
 }
 
+void UiMainMenu::SetEditEnabled(const bool edit_enabled) {
+  edit_enabled_ = edit_enabled;
+}
+
 void UiMainMenu::NewFile() const { p_doc_man_->CreateNewDocument(); }
 
 void UiMainMenu::CloseFile() {
   if (p_doc_man_->CloseDocumentWithCheck(
-        p_doc_man_->GetCurrentDocumentIndex()) >= 0) {
+        p_doc_man_->GetCurrentDocumentHandle()) == CloseResult::kUnsaved) {
     show_unsaved_dialog_ = true;
   }
 }
 
 void UiMainMenu::SaveFileDialog() {
-  if (p_doc_man_->GetCurrentDocumentIndex() >= 0) {
+  if (p_doc_man_->GetCurrentDocument()) {
     show_save_dialog_ = true;
   }
 }
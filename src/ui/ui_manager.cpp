@@ -20,20 +20,27 @@
  */
 #include <SDL3/SDL_render.h>
 #include <imgui.h>
+#include <ui/ui_elements.h>
 #include <ui/ui_manager.h>
 
+#include <format>
+
 namespace linea_one::ui {
 
 UiManager::UiManager(const std::shared_ptr<DocumentManager>& p_doc_man,
     const std::shared_ptr<SDL_Renderer>& p_renderer,
     const std::shared_ptr<InputManager>& p_input_man)
   : p_doc_man_(p_doc_man), p_renderer_(p_renderer), p_input_man_(p_input_man) {
+  p_text_cache_ = std::make_shared<TextMeasureCache>(elements::MeasureText);
   p_main_menu_ = std::make_unique<UiMainMenu>(p_doc_man_);
-  p_doc_tab_ = std::make_shared<UiDocumentTab>(p_renderer_, p_doc_man_);
-  p_modal_dialogs_ = std::make_unique<UiModalDialogs>(p_doc_man_);
+  p_doc_tab_ =
+    std::make_shared<UiDocumentTab>(p_renderer_, p_doc_man_, p_text_cache_);
+  p_modal_dialogs_ =
+    std::make_unique<UiModalDialogs>(p_doc_man_, p_text_cache_);
 }
 
 void UiManager::RenderMenu() {
+  p_main_menu_->SetEditEnabled(!p_doc_tab_->IsSorting());
   p_main_menu_->Render();
   show_unsaved_dialog_ = p_main_menu_->IsShowUnsavedDialog();
   stop_rendering_ = p_main_menu_->IsStopRendering();
@@ -45,19 +52,31 @@ void UiManager::RenderMenu() {
 
 void UiManager::RenderContent() {
   RenderTabs();
+  p_doc_tab_->ReleaseClosedViews();
   if (const auto current_document = p_doc_man_->GetCurrentDocument()) {
-    auto current_document_index = p_doc_man_->GetCurrentDocumentIndex();
-    RenderTabContent(*current_document,  current_document_index);
+    const auto current_handle = p_doc_man_->GetCurrentDocumentHandle();
+    RenderTabContent(*current_document, current_handle);
     if (p_input_man_->HandleShortcuts() == ASCII_S && sort_request_ == false) {
       sort_request_ = true;
-      p_doc_tab_->StartSort(*current_document,  current_document_index, [this](Document& document_document, uint64_t index_index) {
-        p_doc_man_->SetDocOnIndex(document_document, index_index);
-      });
+      p_doc_man_->SortDocument(current_handle);
     }
     if (p_input_man_->HandleShortcuts() == ASCII_A && new_tab_request_ == false && !p_doc_tab_->IsSorting()) {
       p_doc_tab_->AddNewEvent(*current_document);
       new_tab_request_ = true;
     }
+    if (const auto key = p_input_man_->HandleShortcuts();
+        (key == ASCII_Z || key == ASCII_Y) && history_request_ == false &&
+        !p_doc_tab_->IsSorting()) {
+      if (key == ASCII_Z) {
+        p_doc_man_->Undo();
+      } else {
+        p_doc_man_->Redo();
+      }
+      history_request_ = true;
+    }
+    if (p_input_man_->HandleShortcuts() == 0 && history_request_ == true) {
+      history_request_ = false;
+    }
     if (p_input_man_->HandleShortcuts() == 0 && new_tab_request_ == true) {
       new_tab_request_ = false;
     }
@@ -88,26 +107,28 @@ void UiManager::RenderContent() {
     show_load_dialog_ = p_modal_dialogs_->GetShowLoadDialog();
     p_main_menu_->SetShowLoadDialog(show_load_dialog_);
   }
+  if (p_modal_dialogs_->GetShowRecoveryDialog()) {
+    p_modal_dialogs_->RenderRecoveryDialog();
+  }
 }
 
 void UiManager::RenderTabs() {
   if (ImGui::BeginTabBar("DocumentTabs", ImGuiTabBarFlags_AutoSelectNewTabs)) {
-    for (int32_t i = 0; i < p_doc_man_->DocumentSize(); ++i) {
+    // A copy, closing a tab changes the order
+    const auto tabs = p_doc_man_->GetDocuments();
+    for (const auto handle : tabs) {
       bool open = true;
-      if (ImGui::BeginTabItem(p_doc_man_->GetSpecificDocument(i).name.c_str(),
-            &open, ImGuiTabItemFlags_None)) {
-        p_doc_man_->SetCurrentDocumentIndex(i);
+      const auto& name = p_doc_man_->GetDocument(handle)->name;
+      const auto label = std::format("{}{}###{}", name,
+        p_doc_man_->IsSaving(handle) ? " (saving...)" : "", name);
+      if (ImGui::BeginTabItem(label.c_str(), &open, ImGuiTabItemFlags_None)) {
+        p_doc_man_->SetCurrentDocument(handle);
         ImGui::EndTabItem();
       }
-      if (!open) {
-        const auto index_to_close = p_doc_man_->CloseDocumentWithCheck(i);
-        if (index_to_close == -1) {
-          i--;
-        }
-        if (index_to_close > -1) {
-          show_unsaved_dialog_ = true;
-          SetSharedVars();
-        }
+      if (!open && p_doc_man_->CloseDocumentWithCheck(handle) ==
+                     CloseResult::kUnsaved) {
+        show_unsaved_dialog_ = true;
+        SetSharedVars();
       }
     }
     if (ImGui::TabItemButton(
@@ -118,8 +139,9 @@ void UiManager::RenderTabs() {
   }
 }
 
-void UiManager::RenderTabContent(Document& doc, uint64_t index) const {
-  p_doc_tab_->Render(doc, index);
+void UiManager::RenderTabContent(
+  Document& doc, DocumentHandle const handle) const {
+  p_doc_tab_->Render(doc, handle);
 }
 
 void UiManager::SetShowUnsavedDialog(const bool show_unsaved_dialog) {
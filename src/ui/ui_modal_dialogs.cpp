@@ -19,22 +19,37 @@
  * Created by kureii on 8/15/24
  */
 #include <imgui.h>
+#include <io/io_document_format.h>
+#include <ui/ui_elements.h>
 #include <ui/ui_modal_dialogs.h>
+
+#include <algorithm>
+#include <cstring>
 namespace linea_one::ui {
 
 UiModalDialogs::UiModalDialogs(
-  const std::shared_ptr<DocumentManager>& p_doc_man)
-  : p_doc_man_(p_doc_man) {
+  const std::shared_ptr<DocumentManager>& p_doc_man,
+  const std::shared_ptr<TextMeasureCache>& p_text_cache)
+  : p_doc_man_(p_doc_man)
+  , p_text_cache_(p_text_cache)
+  , export_doc_(p_text_cache) {
 #if defined(_WIN32) || defined(_WIN64)
   current_path_ = std::getenv("USERPROFILE");
 #else
   current_path_ = std::getenv("HOME");
 #endif
   RefreshDirectoryContents();
-  export_doc_ = ExportDocument();
+  recoveries_ = p_doc_man_->FindRecoveries();
+  show_recovery_dialog_ = !recoveries_.empty();
 }
 
 void UiModalDialogs::RenderUnsavedChanges() {
+  // The document may have been closed some other way meanwhile
+  auto* p_document = p_doc_man_->GetDocument(p_doc_man_->GetDocToClose());
+  if (!p_document) {
+    show_unsaved_dialog_ = false;
+    return;
+  }
   show_unsaved_dialog_ = true;
   ImGui::OpenPopup("Unsaved Changes");
 
@@ -42,19 +57,16 @@ void UiModalDialogs::RenderUnsavedChanges() {
         "Unsaved Changes", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
     ImGui::Text("Document '%s' has unsaved changes. Do you want to save before "
                 "closing?",
-      p_doc_man_->GetSpecificDocument(p_doc_man_->GetDocToClose())
-        .name.c_str());
+      p_document->name.c_str());
     ImGui::Separator();
 
     if (ImGui::Button("Save", ImVec2(120, 0))) {
-      if (p_doc_man_->GetSpecificDocument(p_doc_man_->GetDocToClose())
-            .path.empty()) {
+      if (p_document->path.empty()) {
         show_save_dialog_ = true;
         show_unsaved_dialog_ = false;
       } else {
-        p_doc_man_->SaveDocument();
-        p_doc_man_->GetSpecificDocument(p_doc_man_->GetDocToClose()).saved =
-          true;
+        p_doc_man_->SaveDocument(p_doc_man_->GetDocToClose());
+        p_document->saved = true;
         p_doc_man_->CloseDocument();
         ImGui::CloseCurrentPopup();
         show_unsaved_dialog_ = false;
@@ -109,28 +121,46 @@ void UiModalDialogs::RenderSaveDialog() {
           strncpy(
             file_name_buffer_, entry.c_str(), sizeof(file_name_buffer_) - 1);
           file_name_buffer_[sizeof(file_name_buffer_) - 1] = '\0';
+          if (io::IsDocumentPath(entry)) {
+            index_format_ = static_cast<int>(io::FormatFromPath(entry));
+          }
         }
       }
     }
     ImGui::EndChild();
 
     ImGui::InputText("File Name", file_name_buffer_, sizeof(file_name_buffer_));
+    if (ImGui::BeginCombo("Format", format_items_[index_format_])) {
+      for (int n = 0; n < IM_ARRAYSIZE(format_items_); n++) {
+        const bool is_selected = (index_format_ == n);
+        if (ImGui::Selectable(format_items_[n], is_selected)) {
+          index_format_ = n;
+        }
+        if (is_selected) {
+          ImGui::SetItemDefaultFocus();
+        }
+      }
+      ImGui::EndCombo();
+    }
 
     if (ImGui::Button("Save", ImVec2(120, 0))) {
       std::string file_name = file_name_buffer_;
 
-      const std::string extension = ".jsonlo";
-      if (file_name.length() >= extension.length()) {
-        if (file_name.compare(file_name.length() - extension.length(),
-              extension.length(), extension) != 0) {
-          file_name += extension;
-        }
-      } else {
-        file_name += extension;
+      // A picked file of another format gets its extension replaced
+      if (io::IsDocumentPath(file_name)) {
+        file_name.resize(file_name.length() -
+                         std::strlen(io::ExtensionOf(io::FormatFromPath(file_name))));
       }
+      file_name += io::ExtensionOf(static_cast<io::DocumentFormat>(index_format_));
 
       auto full_path = current_path_ / file_name;
-      p_doc_man_->GetCurrentDocument()->path = full_path;
+      p_text_cache_->SetFont(elements::FontKey());
+      auto* document = p_doc_man_->GetCurrentDocument();
+      if (document->path != full_path) {
+        // Nothing is stored at the new path yet, even for an unmodified doc
+        document->path = full_path;
+        document->saved = false;
+      }
       p_doc_man_->SaveDocument();
       show_save_dialog_ = false;
       ImGui::CloseCurrentPopup();
@@ -145,6 +175,42 @@ void UiModalDialogs::RenderSaveDialog() {
   }
 }
 
+void UiModalDialogs::RenderRecoveryDialog() {
+  ImGui::OpenPopup("Restore Documents");
+
+  if (ImGui::BeginPopupModal(
+        "Restore Documents", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+    ImGui::Text("These documents had unsaved changes in the last session:");
+    for (const auto& recovery : recoveries_) {
+      ImGui::BulletText("%s (%s)", recovery.name.c_str(),
+        recovery.source_path.empty()
+          ? "never saved"
+          : recovery.source_path.string().c_str());
+    }
+    ImGui::Separator();
+
+    if (ImGui::Button("Restore", ImVec2(120, 0))) {
+      p_doc_man_->RestoreDocuments(recoveries_);
+      show_recovery_dialog_ = false;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Discard", ImVec2(120, 0))) {
+      p_doc_man_->DiscardRecoveries(recoveries_);
+      show_recovery_dialog_ = false;
+    }
+    ImGui::SameLine();
+    // Keeps the files, the dialog comes back on the next start
+    if (ImGui::Button("Later", ImVec2(120, 0))) {
+      show_recovery_dialog_ = false;
+    }
+    if (!show_recovery_dialog_) {
+      recoveries_.clear();
+      ImGui::CloseCurrentPopup();
+    }
+    ImGui::EndPopup();
+  }
+}
+
 void UiModalDialogs::RenderExportDialog() {
   if (show_export_dialog_) {
     ImGui::OpenPopup("Export");
@@ -229,6 +295,17 @@ void UiModalDialogs::RenderLoadDialog() {
       if (current_path_.has_parent_path()) {
         current_path_ = current_path_.parent_path();
         RefreshDirectoryContents();
+        selected_files_.clear();
+        selected_index_ = -1;
+      }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Select all")) {
+      selected_files_.clear();
+      for (const auto& entry : dir_contents_) {
+        if (io::IsDocumentPath(current_path_ / entry)) {
+          selected_files_.push_back(current_path_ / entry);
+        }
       }
     }
     ImGui::BeginChild("File Browser", ImVec2(0, 300), true);
@@ -237,27 +314,56 @@ void UiModalDialogs::RenderLoadDialog() {
       std::filesystem::path entry_path = current_path_ / entry;
       bool is_dir = is_directory(entry_path);
       std::string label = (is_dir ? "[D] " : "    ") + entry;
+      const auto selected = std::ranges::find(selected_files_, entry_path);
 
-      if (ImGui::Selectable(
-            label.c_str(), selected_index_ == static_cast<int>(i))) {
-        selected_index_ = static_cast<int>(i);
+      if (ImGui::Selectable(label.c_str(), selected != selected_files_.end())) {
         if (is_dir) {
           current_path_ /= entry;
           RefreshDirectoryContents();
+          selected_files_.clear();
           selected_index_ = -1;
-        } else if (entry_path.extension() == ".jsonlo") {
-          selected_file_ = entry_path;
+          break;
+        }
+        if (!io::IsDocumentPath(entry_path)) {
+          continue;
         }
+        // Ctrl toggles one file, Shift adds the range from the last click
+        if (ImGui::GetIO().KeyShift && selected_index_ >= 0) {
+          const auto [first, last] =
+            std::minmax(static_cast<size_t>(selected_index_), i);
+          for (size_t n = first; n <= last; ++n) {
+            const auto path = current_path_ / dir_contents_[n];
+            if (io::IsDocumentPath(path) &&
+                std::ranges::find(selected_files_, path) ==
+                  selected_files_.end()) {
+              selected_files_.push_back(path);
+            }
+          }
+        } else if (ImGui::GetIO().KeyCtrl) {
+          if (selected != selected_files_.end()) {
+            selected_files_.erase(selected);
+          } else {
+            selected_files_.push_back(entry_path);
+          }
+        } else {
+          selected_files_ = {entry_path};
+        }
+        selected_index_ = static_cast<int>(i);
       }
     }
     ImGui::EndChild();
 
-    if (selected_file_) {
-      ImGui::Text(
-        "Selected File: %s", selected_file_->filename().string().c_str());
+    if (!selected_files_.empty()) {
+      if (selected_files_.size() == 1) {
+        ImGui::Text("Selected File: %s",
+          selected_files_.front().filename().string().c_str());
+      } else {
+        ImGui::Text("Selected Files: %zu", selected_files_.size());
+      }
 
       if (ImGui::Button("Load", ImVec2(120, 0))) {
-        p_doc_man_->LoadDocument(selected_file_.value());
+        p_doc_man_->LoadDocuments(selected_files_);
+        selected_files_.clear();
         show_load_dialog_ = false;
         ImGui::CloseCurrentPopup();
       }
@@ -305,4 +411,7 @@ bool UiModalDialogs::GetShowSaveDialog() const { return show_save_dialog_; }
 
 bool UiModalDialogs::GetShowLoadDialog() const { return show_load_dialog_; }
 bool UiModalDialogs::GetShowExportDialog() const { return show_export_dialog_; }
+bool UiModalDialogs::GetShowRecoveryDialog() const {
+  return show_recovery_dialog_;
+}
 }  // namespace linea_one::ui
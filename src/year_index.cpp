@@ -0,0 +1,165 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: year_index.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <year_index.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace linea_one {
+
+void YearIndex::Insert(int const year, uint32_t const position) {
+  auto& positions = groups_[year];
+  // Appending is the common case, events are added at the end
+  if (positions.empty() || positions.back() < position) {
+    positions.push_back(position);
+  } else {
+    positions.insert(std::ranges::upper_bound(positions, position), position);
+  }
+}
+
+void YearIndex::Remove(int const year, uint32_t const position) {
+  auto group = groups_.find(year);
+  if (group == groups_.end()) {
+    return;
+  }
+  auto& positions = group->second;
+  auto found = std::ranges::lower_bound(positions, position);
+  if (found == positions.end() || *found != position) {
+    return;
+  }
+  positions.erase(found);
+  if (positions.empty()) {
+    groups_.erase(group);
+  }
+}
+
+void YearIndex::Move(int const from, int const to, uint32_t const position) {
+  if (from == to) {
+    return;
+  }
+  Insert(to, position);
+  Remove(from, position);
+}
+
+void YearIndex::Relocate(
+  int const year, uint32_t const from, uint32_t const to) {
+  auto group = groups_.find(year);
+  if (group == groups_.end()) {
+    return;
+  }
+  auto& positions = group->second;
+  auto found = std::ranges::lower_bound(positions, from);
+  if (found == positions.end() || *found != from) {
+    return;
+  }
+  *found = to;
+  // Rotated to where it sorts, a step to a neighbouring position stays put
+  if (to > from) {
+    std::rotate(found, found + 1, std::upper_bound(found + 1, positions.end(), to));
+  } else {
+    const auto slot = std::upper_bound(positions.begin(), found, to);
+    std::rotate(slot, found, found + 1);
+  }
+}
+
+void YearIndex::Shift(
+  uint32_t const first, uint32_t const last, int const delta) {
+  for (auto& [group_year, positions] : groups_) {
+    for (auto& position : positions) {
+      position += delta * ((position >= first) & (position <= last));
+    }
+  }
+}
+
+void YearIndex::Erase(int const year, uint32_t const position) {
+  Remove(year, position);
+  // Branch free over whole groups, faster than searching each group
+  for (auto& [group_year, positions] : groups_) {
+    for (auto& later : positions) {
+      later -= later > position;
+    }
+  }
+}
+
+void YearIndex::InsertBefore(int const year, uint32_t const position) {
+  for (auto& [group_year, positions] : groups_) {
+    for (auto& later : positions) {
+      later += later >= position;
+    }
+  }
+  Insert(year, position);
+}
+
+void YearIndex::Swap(
+  int const year_a, uint32_t const a, int const year_b, uint32_t const b) {
+  if (year_a == year_b) {
+    return;
+  }
+  Insert(year_a, b);
+  Remove(year_a, a);
+  Insert(year_b, a);
+  Remove(year_b, b);
+}
+
+void YearIndex::Rebuild(std::span<const EventDate> const dates) {
+  groups_.clear();
+  // Sorted documents hit the same group many times in a row
+  auto group = groups_.end();
+  for (uint32_t i = 0; i < dates.size(); ++i) {
+    const int year = dates[i].Year();
+    if (group == groups_.end() || group->first != year) {
+      group = groups_.try_emplace(year).first;
+    }
+    group->second.push_back(i);
+  }
+}
+
+void YearIndex::Compact(std::span<const uint32_t> const moved_to) {
+  for (auto group = groups_.begin(); group != groups_.end();) {
+    auto& positions = group->second;
+    std::erase_if(positions, [&moved_to](uint32_t const position) {
+      return moved_to[position] == UINT32_MAX;
+    });
+    for (auto& position : positions) {
+      position = moved_to[position];
+    }
+    group = positions.empty() ? groups_.erase(group) : std::next(group);
+  }
+}
+
+void YearIndex::Clear() { groups_.clear(); }
+
+bool YearIndex::Empty() const { return groups_.empty(); }
+
+int YearIndex::Min() const { return groups_.begin()->first; }
+
+int YearIndex::Max() const { return groups_.rbegin()->first; }
+
+YearIndex::Range YearIndex::Between(int const first, int const last) const {
+  if (first > last) {
+    return {groups_.end(), groups_.end()};
+  }
+  return {groups_.lower_bound(first), groups_.upper_bound(last)};
+}
+
+const YearIndex::Groups& YearIndex::All() const { return groups_; }
+
+}  // namespace linea_one
@@ -0,0 +1,101 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: cli_export_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <cli.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+#define CLI_EXPORT_TEST_FILES 16
+#define CLI_EXPORT_TEST_RUNS 5
+
+using namespace linea_one;
+
+namespace {
+
+int RunCli(std::vector<std::string> arguments) {
+  arguments.insert(arguments.begin(), "lineaone-cli");
+  std::vector<char*> argv;
+  for (auto& argument : arguments) {
+    argv.push_back(argument.data());
+  }
+  return Cli().Run(static_cast<int>(argv.size()), argv.data());
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+}  // namespace
+
+int main() {
+  const auto directory =
+    std::filesystem::temp_directory_path() / "cli_export_test";
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+  std::filesystem::create_directories(directory);
+
+  // Distinct headlines in every file, the workers measure different texts
+  DocumentManager doc_man;
+  std::vector<std::string> inputs;
+  for (int file = 0; file < CLI_EXPORT_TEST_FILES; ++file) {
+    Document document;
+    document.name = std::format("File {}", file);
+    for (uint64_t i = 0; i < 2000; ++i) {
+      document.events.emplace_back(i + 1,
+        EventDate(static_cast<int>(i % 300)),
+        std::format("Event {} of file {}", i, file), false, "");
+    }
+    const auto path = directory / std::format("f{}.jsonlo", file);
+    CHECK(doc_man.WriteDocument(document, path, io::DocumentFormat::kJsonlo));
+    inputs.push_back(path.string());
+  }
+
+  std::vector<std::string> serial = {
+    "export", "-j", "1", "-o", (directory / "serial").string()};
+  serial.insert(serial.end(), inputs.begin(), inputs.end());
+  CHECK(RunCli(serial) == CLI_EXIT_OK);
+
+  for (int run = 0; run < CLI_EXPORT_TEST_RUNS; ++run) {
+    const auto output = directory / std::format("parallel{}", run);
+    std::vector<std::string> parallel = {
+      "export", "-j", "8", "-o", output.string()};
+    parallel.insert(parallel.end(), inputs.begin(), inputs.end());
+    CHECK(RunCli(parallel) == CLI_EXIT_OK);
+    for (int file = 0; file < CLI_EXPORT_TEST_FILES; ++file) {
+      const auto name = std::format("f{}.svg", file);
+      const auto svg = ReadFile(output / name);
+      CHECK(!svg.empty());
+      CHECK(svg == ReadFile(directory / "serial" / name));
+    }
+  }
+
+  std::filesystem::remove_all(directory, error);
+  return test::Result();
+}
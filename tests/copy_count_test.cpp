@@ -0,0 +1,123 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: copy_count_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <document_manager.h>
+
+#include <filesystem>
+#include <thread>
+
+#include "test_check.h"
+
+// ctest reports the test as skipped, see SKIP_RETURN_CODE
+#define COPY_COUNT_TEST_SKIPPED 77
+
+using namespace linea_one;
+
+namespace {
+
+uint64_t DocumentCopies() { return CopyCounter<Document>::Copies(); }
+uint64_t EventCopies() { return CopyCounter<TimelineEvent>::Copies(); }
+
+template <typename Busy>
+void WaitWhile(DocumentManager& doc_man, const Busy& busy) {
+  while (busy()) {
+    doc_man.Update();
+    std::this_thread::yield();
+  }
+  doc_man.Update();
+}
+
+}  // namespace
+
+int main() {
+  {
+    // With NDEBUG nothing is counted and every check below would pass
+    const TimelineEvent event{};
+    const TimelineEvent copy = event;
+    if (EventCopies() == 0) {
+      std::cout << "copies are not counted in this build" << std::endl;
+      return COPY_COUNT_TEST_SKIPPED;
+    }
+  }
+
+  uint64_t events_before = EventCopies();
+  EventStore store;
+  for (uint64_t i = 0; i < 100; ++i) {
+    store.emplace_back(i + 1, EventDate(static_cast<int>(100 - i)),
+      "headline", false, "description");
+  }
+  // An EventRef reads the columns in place, converting it builds one event
+  const auto event = store[0];
+  CHECK(event.id == 1);
+  CHECK(event.headline.str() == "headline");
+  const TimelineEvent owned = store[1];
+  CHECK(owned.description == "description");
+  std::size_t count = 0;
+  for (const auto& ref : store) {
+    count += ref.headline.size() > 0;
+  }
+  CHECK(count == store.size());
+  CHECK(EventCopies() == events_before);
+
+  const auto path =
+    std::filesystem::temp_directory_path() / "copy_count_test.jsonlo";
+  const uint64_t documents_before = DocumentCopies();
+  events_before = EventCopies();
+  {
+    DocumentManager doc_man;
+    doc_man.SetAutosaveInterval(std::chrono::seconds(0));
+    doc_man.SetJournalMode(false);
+
+    const auto created = doc_man.CreateNewDocument();
+    auto* p_document = doc_man.GetDocument(created);
+    for (uint64_t i = 0; i < 1000; ++i) {
+      p_document->events.emplace_back(i + 1,
+        EventDate(static_cast<int>((i * 7919) % 3000)), "headline", false, "");
+    }
+    p_document->path = path;
+
+    doc_man.SortDocument(created);
+    WaitWhile(doc_man, [&] { return doc_man.IsSorting(created); });
+    CHECK(doc_man.GetDocument(created)->events.sorted_by_date());
+
+    doc_man.SaveDocument(created);
+    WaitWhile(doc_man, [&] { return doc_man.IsSaving(created); });
+    CHECK(std::filesystem::exists(path));
+
+    const auto loaded = doc_man.LoadDocument(path);
+    CHECK(doc_man.GetDocument(loaded) != nullptr);
+    doc_man.LoadDocuments({path, path});
+    WaitWhile(doc_man, [&] { return doc_man.IsLoading(); });
+    CHECK(doc_man.GetDocuments().size() == 4);
+
+    for (const auto handle : std::vector(doc_man.GetDocuments())) {
+      doc_man.GetDocument(handle)->saved = true;
+      CHECK(doc_man.CloseDocumentWithCheck(handle) == CloseResult::kClosed);
+    }
+    CHECK(doc_man.GetDocuments().empty());
+  }
+  CHECK(DocumentCopies() == documents_before);
+  CHECK(EventCopies() == events_before);
+
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  std::filesystem::remove(path.string() + ".journal", error);
+  return test::Result();
+}
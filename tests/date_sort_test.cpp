@@ -0,0 +1,159 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: date_sort_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <date_sort.h>
+#include <document_manager.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+std::vector<EventDate> RandomDates(
+  std::size_t const count, int const years, std::mt19937& random) {
+  std::vector<EventDate> dates;
+  dates.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const int year = static_cast<int>(random() % years) - years / 2;
+    // Whole years, months and days mixed, equal dates test stability
+    switch (random() % 3) {
+      case 0: dates.push_back(EventDate(year)); break;
+      case 1: dates.push_back(*EventDate::Make(year, 1 + random() % 12)); break;
+      default:
+        dates.push_back(*EventDate::Make(
+          year, 1 + random() % 12, 1 + random() % 28, random() % 86400));
+    }
+  }
+  return dates;
+}
+
+std::vector<uint64_t> StableOrder(const std::vector<EventDate>& dates) {
+  std::vector<uint64_t> order(dates.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(
+    order, {}, [&dates](uint64_t const i) { return dates[i]; });
+  return order;
+}
+
+EventStore MakeStore(const std::vector<EventDate>& dates) {
+  EventStore store;
+  store.reserve(dates.size());
+  for (std::size_t i = 0; i < dates.size(); ++i) {
+    store.emplace_back(i + 1, dates[i], "headline", false, "");
+  }
+  return store;
+}
+
+bool SameEvents(const EventStore& store, const std::vector<EventDate>& dates) {
+  if (store.size() != dates.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < dates.size(); ++i) {
+    if (store[i].id != i + 1 || EventDate(store[i].date) != dates[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 random(22);
+
+  CHECK(SortDates({})->empty());
+  // Packed keys, and pairs when the date range and positions need more
+  // than 64 bits
+  for (const int years : {50, 5000, 200000000}) {
+    for (const std::size_t count : {1ul, 1000ul, 200000ul}) {
+      const auto dates = RandomDates(count, years, random);
+      CHECK(SortDates(dates) == StableOrder(dates));
+    }
+  }
+
+  // Stopped between two passes
+  const auto dates = RandomDates(300000, 5000, random);
+  std::stop_source source;
+  int passes = 0;
+  const auto stopped = SortDates(dates, source.get_token(), [&](float) {
+    if (++passes == 1) {
+      source.request_stop();
+    }
+  });
+  CHECK(!stopped.has_value());
+  CHECK(passes == 1);
+
+  // The store is left as it was, indexes included
+  EventStore store = MakeStore(dates);
+  std::stop_source store_source;
+  const auto store_order = store.sort_by_date(
+    store_source.get_token(), [&](float const done) {
+      if (done > 0) {
+        store_source.request_stop();
+      }
+    });
+  CHECK(!store_order.has_value());
+  CHECK(SameEvents(store, dates));
+  CHECK(!store.sorted_by_date());
+  CHECK(store.year_groups().size() == MakeStore(dates).year_groups().size());
+
+  // A cancelled document sort is dropped even when it finished first
+  DocumentManager doc_man;
+  doc_man.SetAutosaveInterval(std::chrono::seconds(0));
+  const auto handle = doc_man.CreateNewDocument();
+  doc_man.GetDocument(handle)->events = MakeStore(dates);
+  doc_man.SortDocument(handle);
+  CHECK(doc_man.IsSorting(handle));
+  CHECK(doc_man.GetSortProgress(handle).has_value());
+  doc_man.CancelSort(handle);
+  while (doc_man.IsSorting(handle)) {
+    doc_man.Update();
+    std::this_thread::yield();
+  }
+  CHECK(!doc_man.GetSortProgress(handle).has_value());
+  CHECK(SameEvents(doc_man.GetDocument(handle)->events, dates));
+
+  // Not cancelled, the sorted store replaces the events
+  doc_man.SortDocument(handle);
+  while (doc_man.IsSorting(handle)) {
+    doc_man.Update();
+    std::this_thread::yield();
+  }
+  const auto& sorted = doc_man.GetDocument(handle)->events;
+  const auto order = StableOrder(dates);
+  CHECK(sorted.sorted_by_date());
+  CHECK(sorted.size() == dates.size());
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    if (sorted[i].id != order[i] + 1) {
+      CHECK(sorted[i].id == order[i] + 1);
+      break;
+    }
+  }
+
+  return test::Result();
+}
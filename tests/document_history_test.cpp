@@ -0,0 +1,396 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: document_history_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <document.h>
+#include <document_history.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+struct Row {
+  uint64_t id;
+  int64_t date;
+  std::string headline;
+  std::string description;
+  bool expanded;
+  bool operator==(const Row&) const = default;
+};
+
+std::vector<Row> Rows(const EventStore& events) {
+  std::vector<Row> rows;
+  for (const auto event : events) {
+    rows.push_back({event.id, EventDate(event.date).Key(),
+      std::string(event.headline.str()), std::string(event.description.str()),
+      bool(event.expanded)});
+  }
+  return rows;
+}
+
+Document MakeDocument(std::size_t const count) {
+  Document document;
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto id = document.events.allocate_id();
+    document.events.emplace_back(id, EventDate(static_cast<int>(i) * 10),
+      "headline " + std::to_string(id), false, "description");
+  }
+  return document;
+}
+
+bool Undo(Document& document) {
+  return document.history.Undo(document.events, document.changes);
+}
+
+bool Redo(Document& document) {
+  return document.history.Redo(document.events, document.changes);
+}
+
+// Edits the way UiDocumentTab does, recording each into the history
+class Editor {
+ public:
+  Editor(Document& document, std::mt19937& random)
+    : document_(document), random_(random) {}
+
+  void Insert() {
+    const auto id = document_.events.allocate_id();
+    const auto position = Pick(document_.events.size() + 1);
+    document_.events.insert(position,
+      TimelineEvent{
+        id, EventDate(static_cast<int>(Pick(1000))), "new", false, ""});
+    document_.history.RecordInsert(position, document_.events[position]);
+  }
+
+  void Delete() {
+    const auto position = Pick(document_.events.size());
+    document_.history.RecordDelete(
+      position, static_cast<TimelineEvent>(document_.events[position]));
+    document_.events.erase(position);
+  }
+
+  /* A drag over a few frames, auto order moves the event after each. */
+  void DragDate(std::size_t position, int const frames) {
+    const uint64_t id = document_.events.ids()[position];
+    for (int frame = 0; frame < frames; ++frame) {
+      position = document_.events.find(id).Index();
+      auto event = document_.events[position];
+      const EventDate before = event.date;
+      event.date =
+        before.WithYear(before.Year() + static_cast<int>(Pick(61)) - 30);
+      document_.history.RecordDate(id, before, event.date);
+      Reposition(id);
+    }
+    document_.history.Seal();
+  }
+
+  void Reposition(uint64_t const id) {
+    const auto from = document_.events.find(id).Index();
+    const auto to = document_.events.ordered_position(from);
+    if (from != to) {
+      document_.events.move(from, to);
+      document_.history.RecordMove(id, document_.events[to].date, from, to);
+    }
+  }
+
+  /* Keystrokes into one field, each inserting or deleting one letter. */
+  void Type(TextField const field, int const keystrokes) {
+    const uint64_t id = document_.events.ids()[Pick(document_.events.size())];
+    for (int key = 0; key < keystrokes; ++key) {
+      auto event = *document_.events.find(id);
+      auto target =
+        field == TextField::kHeadline ? event.headline : event.description;
+      const std::string before(target.str());
+      std::string after = before;
+      if (!after.empty() && Pick(3) == 0) {
+        after.erase(Pick(after.size()), 1);
+      } else {
+        after.insert(Pick(after.size() + 1), 1,
+          static_cast<char>('a' + Pick(26)));
+      }
+      document_.history.RecordText(id, field, before, after);
+      target = after;
+    }
+    document_.history.Seal();
+  }
+
+  void ToggleExpanded() {
+    auto event = document_.events[Pick(document_.events.size())];
+    event.expanded = !event.expanded;
+    document_.history.RecordExpanded(event.id);
+  }
+
+  void Swap() {
+    const auto a = Pick(document_.events.size());
+    const auto b = Pick(document_.events.size());
+    document_.events.swap(a, b);
+    document_.history.RecordSwap(a, b);
+  }
+
+  void Sort() {
+    auto order = document_.events.sort_by_date();
+    if (order && !order->empty()) {
+      document_.history.RecordOrder(std::move(*order));
+    }
+  }
+
+  void Random() {
+    if (document_.events.size() < 2) {
+      Insert();
+      return;
+    }
+    switch (Pick(8)) {
+      case 0: Insert(); break;
+      case 1: Delete(); break;
+      case 2: DragDate(Pick(document_.events.size()), 1 + Pick(6)); break;
+      case 3: Type(TextField::kHeadline, 1 + Pick(8)); break;
+      case 4: Type(TextField::kDescription, 1 + Pick(8)); break;
+      case 5: ToggleExpanded(); break;
+      case 6: Swap(); break;
+      default: Sort(); break;
+    }
+  }
+
+ private:
+  std::size_t Pick(std::size_t const count) { return random_() % count; }
+
+  Document& document_;
+  std::mt19937& random_;
+};
+
+void TestRandomEdits() {
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    std::mt19937 random(seed);
+    Document document = MakeDocument(1 + seed % 7 * 5);
+    Editor editor(document, random);
+    const auto original = Rows(document.events);
+    for (int step = 0; step < 300; ++step) {
+      editor.Random();
+    }
+    const auto edited = Rows(document.events);
+    int undone = 0;
+    while (document.history.CanUndo()) {
+      CHECK(Undo(document));
+      ++undone;
+    }
+    CHECK(Rows(document.events) == original);
+    int redone = 0;
+    while (document.history.CanRedo()) {
+      CHECK(Redo(document));
+      ++redone;
+    }
+    CHECK(redone == undone);
+    CHECK(Rows(document.events) == edited);
+  }
+}
+
+void TestBudget() {
+  std::mt19937 random(5);
+  Document document = MakeDocument(10);
+  Editor editor(document, random);
+  constexpr std::size_t kBudget = 4096;
+  document.history.SetBudget(kBudget);
+  // Every state the events went through, the oldest steps get trimmed
+  std::vector<std::vector<Row>> states{Rows(document.events)};
+  for (int step = 0; step < 200; ++step) {
+    editor.Random();
+    states.push_back(Rows(document.events));
+    CHECK(document.history.Bytes() <= kBudget);
+  }
+  CHECK(document.history.CanUndo());
+  std::size_t undone = 0;
+  while (document.history.CanUndo()) {
+    CHECK(Undo(document));
+    ++undone;
+  }
+  CHECK(undone > 0 && undone < states.size() - 1);
+  // Undoes to the state the oldest kept step started from, not further
+  CHECK(Rows(document.events) != states.front());
+  CHECK(std::ranges::find(states, Rows(document.events)) != states.end());
+  CHECK(document.history.Bytes() <= kBudget);
+
+  // Lowering the budget trims right away
+  document.history.SetBudget(0);
+  CHECK(document.history.Bytes() == 0);
+  CHECK(!document.history.CanUndo() && !document.history.CanRedo());
+}
+
+void TestTextCoalescing() {
+  Document document = MakeDocument(2);
+  auto& history = document.history;
+  const uint64_t id = document.events.ids()[0];
+  auto type = [&](TextField const field, const std::string& after) {
+    auto event = *document.events.find(id);
+    auto target =
+      field == TextField::kHeadline ? event.headline : event.description;
+    history.RecordText(id, field, target.str(), after);
+    target = after;
+  };
+  auto headline = [&] {
+    return std::string((*document.events.find(id)).headline.str());
+  };
+
+  // Typing into the middle and taking a letter back is one step, diffed
+  // against the text before the first keystroke
+  const std::string original = headline();
+  type(TextField::kHeadline, "headXline 1");
+  type(TextField::kHeadline, "headXYline 1");
+  type(TextField::kHeadline, "headYline 1");
+  type(TextField::kHeadline, "headYline 12");
+  const auto bytes = history.Bytes();
+  CHECK(Undo(document));
+  CHECK(headline() == original);
+  CHECK(!history.CanUndo());
+  CHECK(Redo(document));
+  CHECK(headline() == "headYline 12");
+  CHECK(history.Bytes() == bytes);
+
+  // Typing back to where the step began leaves nothing to undo
+  type(TextField::kHeadline, "headYline 123");
+  type(TextField::kHeadline, "headYline 12");
+  CHECK(Undo(document));
+  CHECK(headline() == original);
+  CHECK(Redo(document));
+
+  // Sealed, another field or another event each start a new step
+  history.Seal();
+  type(TextField::kHeadline, "a");
+  type(TextField::kDescription, "b");
+  type(TextField::kHeadline, "ab");
+  CHECK(Undo(document));
+  CHECK(headline() == "a");
+  CHECK(Undo(document));
+  CHECK((*document.events.find(id)).description.str() == "description");
+  CHECK(Undo(document));
+  CHECK(headline() == "headYline 12");
+}
+
+void TestDateDrag() {
+  // Sorted by date, so auto order keeps them sorted
+  Document document = MakeDocument(10);
+  std::mt19937 random(3);
+  Editor editor(document, random);
+  const auto original = Rows(document.events);
+  const uint64_t id = document.events.ids()[2];
+  auto drag = [&](std::initializer_list<int> const years) {
+    for (const int year : years) {
+      auto event = *document.events.find(id);
+      const EventDate before = event.date;
+      event.date = EventDate(year);
+      document.history.RecordDate(id, before, event.date);
+      editor.Reposition(id);
+    }
+    document.history.Seal();
+  };
+
+  // Over several frames the event passes others, one step covers them all
+  drag({25, 45, 75, 95});
+  CHECK(document.events.find(id).Index() == 9);
+  CHECK(document.events.sorted_by_date());
+  const auto dragged = Rows(document.events);
+  CHECK(Undo(document));
+  CHECK(Rows(document.events) == original);
+  CHECK(!document.history.CanUndo());
+  CHECK(Redo(document));
+  CHECK(Rows(document.events) == dragged);
+
+  // Out and back to where it was is a date change only
+  drag({55, 5, 92, 93});
+  CHECK(document.events.find(id).Index() == 9);
+  CHECK(Undo(document));
+  CHECK(Rows(document.events) == dragged);
+  CHECK(Undo(document));
+  CHECK(Rows(document.events) == original);
+}
+
+void TestOrderInversion() {
+  Document document = MakeDocument(3);
+  const auto original = Rows(document.events);
+  // A rotation is its own inverse only when applied three times
+  const std::vector<uint64_t> order{1, 2, 0};
+  document.events.reorder(order);
+  document.history.RecordOrder(order);
+  const auto rotated = Rows(document.events);
+  CHECK(rotated[0] == original[1] && rotated[2] == original[0]);
+  CHECK(Undo(document));
+  CHECK(Rows(document.events) == original);
+  CHECK(Redo(document));
+  CHECK(Rows(document.events) == rotated);
+
+  // An order for a different number of events no longer applies
+  document.events.emplace_back(uint64_t{99}, EventDate(0), "", false, "");
+  CHECK(!Undo(document));
+}
+
+void TestClear() {
+  // An edit that no longer applies clears the whole log
+  Document document = MakeDocument(5);
+  std::mt19937 random(9);
+  Editor editor(document, random);
+  editor.Type(TextField::kHeadline, 3);
+  document.events.swap(3, 4);
+  document.history.RecordSwap(3, 4);
+  editor.Delete();
+  CHECK(Undo(document));
+  // Changed behind the history's back, the swap's positions are gone
+  document.events.resize(1);
+  CHECK(!Undo(document));
+  CHECK(!document.history.CanUndo());
+  CHECK(!document.history.CanRedo());
+  CHECK(document.history.Bytes() == 0);
+
+  // A text edit whose event was deleted without being recorded
+  Document text = MakeDocument(2);
+  Editor text_editor(text, random);
+  text_editor.Type(TextField::kDescription, 2);
+  text.events.erase(0);
+  text.events.erase(0);
+  CHECK(!Undo(text));
+  CHECK(!text.history.CanUndo() && text.history.Bytes() == 0);
+
+  // A redo that no longer applies clears as well
+  Document redo = MakeDocument(3);
+  const auto id = redo.events.allocate_id();
+  redo.events.emplace_back(id, EventDate(50), "", false, "");
+  redo.history.RecordInsert(3, redo.events[3]);
+  CHECK(Undo(redo));
+  CHECK(redo.history.CanRedo());
+  // The id it would put back is taken meanwhile
+  redo.events.emplace_back(id, EventDate(60), "", false, "");
+  CHECK(!Redo(redo));
+  CHECK(!redo.history.CanRedo() && !redo.history.CanUndo());
+}
+
+}  // namespace
+
+int main() {
+  TestRandomEdits();
+  TestBudget();
+  TestTextCoalescing();
+  TestDateDrag();
+  TestOrderInversion();
+  TestClear();
+  return test::Result();
+}
@@ -0,0 +1,137 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: event_store_erase_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <event_store.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+// Both indexes agree with the columns: every id finds its position and
+// every year group holds exactly the positions with that year, in order
+bool Consistent(const EventStore& store) {
+  for (std::size_t i = 0; i < store.size(); ++i) {
+    if (store.find(store.ids()[i]).Index() != i) {
+      return false;
+    }
+  }
+  std::size_t grouped = 0;
+  for (const auto& [year, positions] : store.year_groups()) {
+    if (!std::ranges::is_sorted(positions)) {
+      return false;
+    }
+    for (const auto position : positions) {
+      if (position >= store.size() || store.dates()[position].Year() != year) {
+        return false;
+      }
+    }
+    grouped += positions.size();
+  }
+  return grouped == store.size();
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 random(14);
+  EventStore store;
+  std::vector<uint64_t> expected;
+  // Large enough that positions near the end relocate and the rest sweep
+  for (uint64_t i = 0; i < 2000; ++i) {
+    const auto id = store.allocate_id();
+    store.emplace_back(
+      id, EventDate(static_cast<int>(random() % 50)), "", false, "");
+    expected.push_back(id);
+  }
+  CHECK(Consistent(store));
+
+  for (int step = 0; step < 3000; ++step) {
+    const auto choice = random() % 8;
+    if (choice < 3 && !store.empty()) {
+      // Mostly near the end, where each later event is relocated
+      const std::size_t tail =
+        random() % std::min<std::size_t>(store.size(), 20);
+      const std::size_t index =
+        choice == 0 ? random() % store.size() : store.size() - 1 - tail;
+      store.erase(index);
+      expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+    } else if (choice < 6) {
+      const std::size_t tail =
+        random() % std::min<std::size_t>(store.size() + 1, 20);
+      const std::size_t index =
+        choice == 3 ? random() % (store.size() + 1) : store.size() - tail;
+      const auto id = store.allocate_id();
+      store.insert(index, TimelineEvent{id,
+        EventDate(static_cast<int>(random() % 50)), "", false, ""});
+      expected.insert(
+        expected.begin() + static_cast<std::ptrdiff_t>(index), id);
+    } else if (choice == 6 && !store.empty()) {
+      // Some ids twice and one that was never there
+      std::vector<uint64_t> ids{UINT64_MAX};
+      for (int i = 0; i < 5; ++i) {
+        ids.push_back(expected[random() % expected.size()]);
+      }
+      std::vector<uint64_t> unique = ids;
+      std::ranges::sort(unique);
+      const auto duplicates = std::ranges::unique(unique);
+      unique.erase(duplicates.begin(), duplicates.end());
+      CHECK(store.erase_ids(ids) == unique.size() - 1);
+      std::erase_if(expected, [&unique](uint64_t const id) {
+        return std::ranges::binary_search(unique, id);
+      });
+    } else if (!store.empty()) {
+      store.move(random() % store.size(), random() % store.size());
+      expected.assign(store.ids().begin(), store.ids().end());
+    }
+    if (step % 100 == 0 || store.size() < 40) {
+      CHECK(Consistent(store));
+    }
+    CHECK(std::ranges::equal(store.ids(), expected));
+  }
+  CHECK(Consistent(store));
+
+  // An order that leaves events out drops them, ids included
+  std::vector<uint64_t> order;
+  for (std::size_t i = store.size(); i-- > 0;) {
+    if (i % 3 != 0) {
+      order.push_back(i);
+    }
+  }
+  const uint64_t dropped = store.ids()[0];
+  store.reorder(order);
+  CHECK(Consistent(store));
+  CHECK(!store.contains(dropped));
+  expected.assign(store.ids().begin(), store.ids().end());
+
+  // Deleting everything at once leaves an empty store that still indexes
+  CHECK(store.erase_ids(expected) == expected.size());
+  CHECK(store.empty());
+  store.emplace_back(uint64_t{7}, EventDate(1), "", false, "");
+  CHECK(Consistent(store));
+  CHECK(store.erase_ids(std::vector<uint64_t>{}) == 0);
+
+  return test::Result();
+}
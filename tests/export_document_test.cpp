@@ -0,0 +1,45 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: export_document_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <export_document.h>
+
+#include <string>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+int main() {
+  EventStore events;
+  events.emplace_back(uint64_t{1}, EventDate(1999),
+    "<a & \"b\"> \xC3\xA9 \xF0\x9F\x98\x80", false, "");
+  // Lone lead byte, stray continuation, surrogate, as a .binlo may hold
+  events.emplace_back(
+    uint64_t{2}, EventDate(2000), "bad \xC3 \x80 \xED\xA0\x80 end", false, "");
+
+  ExportDocument export_doc;
+  const std::string svg = export_doc.ExportTimelineToSVG(events, {});
+  CHECK(svg.find("&lt;a &amp; &quot;b&quot;&gt; &#233; &#128512;") !=
+        std::string::npos);
+  CHECK(svg.find("bad &#65533; &#65533; &#65533;&#65533;&#65533; end") !=
+        std::string::npos);
+
+  return test::Result();
+}
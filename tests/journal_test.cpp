@@ -0,0 +1,244 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: journal_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <io/io_journal.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+constexpr uint64_t kHeaderSize = 32;
+
+Document MakeDocument() {
+  Document document;
+  document.state.zoom = 2.0f;
+  document.state.offset = -5.0f;
+  for (uint64_t i = 1; i <= 4; ++i) {
+    document.events.emplace_back(i, EventDate(static_cast<int>(1990 + i)),
+      "headline " + std::to_string(i), i % 2 == 0,
+      "description " + std::to_string(i));
+  }
+  return document;
+}
+
+void CheckSame(const Document& replayed, const Document& expected) {
+  CHECK(replayed.state.zoom == expected.state.zoom);
+  CHECK(replayed.state.offset == expected.state.offset);
+  CHECK(replayed.events.size() == expected.events.size());
+  for (std::size_t i = 0;
+       i < std::min(replayed.events.size(), expected.events.size()); ++i) {
+    const auto a = replayed.events[i];
+    const auto b = expected.events[i];
+    CHECK(a.id == b.id);
+    CHECK(EventDate(a.date) == EventDate(b.date));
+    CHECK(a.headline.str() == std::string(b.headline.str()));
+    CHECK(a.description.str() == std::string(b.description.str()));
+    CHECK(bool(a.expanded) == bool(b.expanded));
+  }
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), {}};
+}
+
+void WriteFile(const std::filesystem::path& path, const std::string& bytes) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file << bytes;
+}
+
+// Edits the document like the ui does and journals them as one save
+void Save(io::Journal& journal, Document& document,
+  const std::filesystem::path& base_path, const auto& edit) {
+  const auto revision = document.changes.Revision();
+  edit(document);
+  CHECK(journal.Append(
+    document, document.changes.Since(revision), base_path));
+}
+
+// A checksummed frame holding the payload, as Journal::EncodeFrame lays it out
+std::string Frame(const std::string& payload) {
+  uint32_t checksum = 2166136261u;
+  for (const char byte : payload) {
+    checksum ^= static_cast<uint8_t>(byte);
+    checksum *= 16777619u;
+  }
+  const uint64_t size = payload.size();
+  std::string frame(12, '\0');
+  std::memcpy(frame.data(), &size, sizeof(size));
+  std::memcpy(frame.data() + 8, &checksum, sizeof(checksum));
+  return frame + payload;
+}
+
+void SetVersion(const std::filesystem::path& journal_path, uint32_t version) {
+  std::fstream file(
+    journal_path, std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(8);
+  file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+}
+
+}  // namespace
+
+int main() {
+  const auto directory =
+    std::filesystem::temp_directory_path() / "lineaone_journal_test";
+  std::error_code error;
+  std::filesystem::remove_all(directory, error);
+  std::filesystem::create_directories(directory);
+  // Only the size and time of the base matter to the journal
+  const auto base_path = directory / "base.jsonlo";
+  const auto journal_path = io::Journal::PathFor(base_path);
+  WriteFile(base_path, "base");
+
+  io::Journal journal;
+  const Document base = MakeDocument();
+  Document edited = base;
+  CHECK(journal.Reset(base_path));
+  CHECK(journal.Size(base_path) == kHeaderSize);
+
+  // Append and replay round trip: edits, a new event, a delete, an order
+  Save(journal, edited, base_path, [](Document& document) {
+    document.events[1].headline = "edited headline";
+    document.events[1].date = *EventDate::Make(1992, 6, 15, 3600);
+    document.changes.MarkEvent(2);
+    document.state.zoom = 3.0f;
+  });
+  Save(journal, edited, base_path, [](Document& document) {
+    document.events.emplace_back(uint64_t{5}, EventDate(-44), "new", true, "");
+    document.changes.MarkEvent(5);
+    document.events.erase(0);
+    document.changes.MarkDeleted(1);
+  });
+  Save(journal, edited, base_path, [](Document& document) {
+    document.events.move(3, 0);
+    document.changes.MarkOrder();
+  });
+  const auto saved_size = journal.Size(base_path);
+  {
+    Document replayed = base;
+    CHECK(journal.Replay(replayed, base_path));
+    CheckSame(replayed, edited);
+    CHECK(journal.Size(base_path) == saved_size);
+    // Replaying twice is harmless
+    CHECK(journal.Replay(replayed, base_path));
+    CheckSame(replayed, edited);
+  }
+
+  // Torn last frame, the save stopped halfway through writing it
+  Document torn = edited;
+  Save(journal, torn, base_path, [](Document& document) {
+    document.events[0].description = "never finished";
+    document.changes.MarkEvent(document.events[0].id);
+  });
+  std::filesystem::resize_file(journal_path, journal.Size(base_path) - 3);
+  {
+    Document replayed = base;
+    CHECK(journal.Replay(replayed, base_path));
+    CheckSame(replayed, edited);
+    CHECK(journal.Size(base_path) == saved_size);
+  }
+
+  // Corrupt checksum, garbage where the last frame should be
+  Document corrupt = edited;
+  Save(journal, corrupt, base_path, [](Document& document) {
+    document.events[0].headline = "garbled";
+    document.changes.MarkEvent(document.events[0].id);
+  });
+  {
+    auto bytes = ReadFile(journal_path);
+    bytes.back() ^= 0x5a;
+    WriteFile(journal_path, bytes);
+    // Rewriting the journal does not touch the base it is bound to
+    CHECK(journal.IsBound(base_path));
+    Document replayed = base;
+    CHECK(journal.Replay(replayed, base_path));
+    CheckSame(replayed, edited);
+    CHECK(journal.Size(base_path) == saved_size);
+  }
+
+  // Unknown record type in a valid frame, e.g. from a newer build
+  {
+    CHECK(journal.AppendFrame(Frame(std::string(1, '\x7f')), base_path));
+    const auto bytes = ReadFile(journal_path);
+    Document replayed = base;
+    CHECK(!journal.Replay(replayed, base_path));
+    CHECK(ReadFile(journal_path) == bytes);
+    Document applied = base;
+    CHECK(!io::Journal::ApplyFrames(applied,
+      bytes.data() + kHeaderSize, bytes.size() - kHeaderSize));
+    std::filesystem::resize_file(journal_path, saved_size);
+  }
+
+  // A journal of a newer version is not read at all, one of the previous
+  // version is replayed but not appended to
+  {
+    SetVersion(journal_path, JOURNAL_VERSION + 1);
+    const auto bytes = ReadFile(journal_path);
+    Document replayed = base;
+    CHECK(!journal.Replay(replayed, base_path));
+    CheckSame(replayed, base);
+    CHECK(ReadFile(journal_path) == bytes);
+
+    SetVersion(journal_path, JOURNAL_MIN_VERSION);
+    if (JOURNAL_MIN_VERSION != JOURNAL_VERSION) {
+      CHECK(journal.Replay(replayed, base_path));
+      CheckSame(replayed, edited);
+      CHECK(!journal.AppendFrame(Frame(""), base_path));
+    }
+    SetVersion(journal_path, JOURNAL_VERSION);
+  }
+
+  // Replay after compaction, frames saved during it survive the rebind
+  {
+    const auto mark = journal.Mark(base_path);
+    CHECK(mark.has_value());
+    const Document compacted = edited;
+    Save(journal, edited, base_path, [](Document& document) {
+      document.events[2].headline = "saved while compacting";
+      document.changes.MarkEvent(document.events[2].id);
+    });
+    const auto compacted_path = directory / "base.jsonlo.compact";
+    WriteFile(compacted_path, "compacted base");
+    CHECK(mark && journal.Rebind(base_path, compacted_path, *mark));
+    CHECK(ReadFile(base_path) == "compacted base");
+    CHECK(journal.IsBound(base_path));
+    Document replayed = compacted;
+    CHECK(journal.Replay(replayed, base_path));
+    CheckSame(replayed, edited);
+
+    // Replaced base, the journal no longer belongs to it
+    WriteFile(base_path, "someone else's file");
+    Document unbound = compacted;
+    CHECK(!journal.Replay(unbound, base_path));
+    CheckSame(unbound, compacted);
+  }
+
+  std::filesystem::remove_all(directory, error);
+  return test::Result();
+}
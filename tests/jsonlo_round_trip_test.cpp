@@ -0,0 +1,117 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: jsonlo_round_trip_test.cpp
+ * Created by kureii on 10/17/26
+ */
+#include <io/io_jsonlo_reader.h>
+#include <io/io_jsonlo_writer.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+Document MakeDocument() {
+  Document document;
+  document.name = "q\"b\\s/ \x01\x1f\t\r\n\b\f end";
+  document.state.zoom = 0.1f;
+  document.state.offset = -3.25e-7f;
+  const std::string texts[] = {"plain", "\"quoted\" \\path\\",
+    "control \x01\x02\x7f", "utf8 \xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80", "",
+    "tab\tnew line\ncarriage\r", std::string("nul \0 inside", 12)};
+  const EventDate dates[] = {EventDate(-500), *EventDate::Make(1999, 3),
+    *EventDate::Make(2000, 2, 29), *EventDate::Make(1, 12, 31, 45296),
+    EventDate(0), *EventDate::Make(-44, 3, 15, 0), EventDate(2024)};
+  for (std::size_t i = 0; i < std::size(texts); ++i) {
+    document.events.emplace_back(i + 1, dates[i], texts[i], i % 2 == 0,
+      texts[std::size(texts) - 1 - i] + " description");
+  }
+  return document;
+}
+
+void CheckSame(const Document& read, const Document& written) {
+  CHECK(read.name == written.name);
+  CHECK(read.state.zoom == written.state.zoom);
+  CHECK(read.state.offset == written.state.offset);
+  CHECK(read.events.size() == written.events.size());
+  for (std::size_t i = 0;
+       i < std::min(read.events.size(), written.events.size()); ++i) {
+    const auto a = read.events[i];
+    const auto b = written.events[i];
+    CHECK(a.id == b.id);
+    CHECK(EventDate(a.date) == EventDate(b.date));
+    CHECK(a.headline.str() == std::string(b.headline.str()));
+    CHECK(a.description.str() == std::string(b.description.str()));
+    CHECK(bool(a.expanded) == bool(b.expanded));
+  }
+}
+
+}  // namespace
+
+int main() {
+  const Document document = MakeDocument();
+  const std::string text = io::JsonloWriter::Write(document);
+
+  // Both writers give the same bytes
+  std::ostringstream streamed;
+  CHECK(io::JsonloWriter::Write(document, streamed));
+  CHECK(streamed.str() == text);
+
+  std::istringstream input(text);
+  const auto read = io::JsonloReader::Read(input, text.size());
+  CHECK(read.has_value());
+  if (read) {
+    CheckSame(*read, document);
+    // Reading what was read back and writing it again changes nothing
+    CHECK(io::JsonloWriter::Write(*read) == text);
+  }
+
+  const auto path =
+    std::filesystem::temp_directory_path() / "jsonlo_round_trip_test.jsonlo";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << text;
+  }
+  const auto lazy = io::JsonloReader::ReadLazy(path);
+  CHECK(lazy.has_value());
+  if (lazy) {
+    CheckSame(*lazy, document);
+  }
+  std::error_code error;
+  std::filesystem::remove(path, error);
+
+  // Invalid UTF-8 is saved as U+FFFD instead of failing the save
+  Document invalid;
+  invalid.events.emplace_back(
+    uint64_t{1}, EventDate(1), "bad \xFF end", false, "cut \xC3");
+  std::istringstream invalid_input(io::JsonloWriter::Write(invalid));
+  const auto replaced = io::JsonloReader::Read(invalid_input);
+  CHECK(replaced.has_value());
+  if (replaced) {
+    CHECK(replaced->events[0].headline.str() == "bad \xEF\xBF\xBD end");
+    CHECK(replaced->events[0].description.str() == "cut \xEF\xBF\xBD");
+  }
+
+  return test::Result();
+}
@@ -0,0 +1,108 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: sorted_between_test.cpp
+ * Created by kureii on 10/18/26
+ */
+#include <event_store.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+
+#include "test_check.h"
+
+using namespace linea_one;
+
+namespace {
+
+using Range = std::pair<std::size_t, std::size_t>;
+
+// What the timeline did before, every event tested against the interval
+Range Scan(const EventStore& store, double const first, double const last) {
+  std::size_t begin = store.size(), end = 0;
+  for (std::size_t i = 0; i < store.size(); ++i) {
+    const double years = store.dates()[i].Years();
+    if (years >= first && years <= last) {
+      begin = std::min(begin, i);
+      end = i + 1;
+    }
+  }
+  return begin < end ? Range{begin, end} : Range{0, 0};
+}
+
+bool Empty(const Range& range) { return range.first == range.second; }
+
+}  // namespace
+
+int main() {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  EventStore store;
+  CHECK(Empty(store.sorted_between(-kInfinity, kInfinity)));
+
+  // 1999, 2000 twice, 2000-07-01, 2000-12-31 23:59:59, 2001
+  const EventDate dates[] = {EventDate(1999), EventDate(2000), EventDate(2000),
+    *EventDate::Make(2000, 7, 1), *EventDate::Make(2000, 12, 31, 86399),
+    EventDate(2001)};
+  for (std::size_t i = 0; i < std::size(dates); ++i) {
+    store.emplace_back(i + 1, dates[i], "", false, "");
+  }
+  CHECK(store.sorted_by_date());
+
+  // Both ends are included, equal dates at an end all are
+  CHECK(store.sorted_between(2000, 2001) == Range(1, 6));
+  CHECK(store.sorted_between(1999, 1999) == Range(0, 1));
+  CHECK(store.sorted_between(2000, 2000) == Range(1, 3));
+  const double july = dates[3].Years();
+  CHECK(store.sorted_between(july, july) == Range(3, 4));
+  // Just past an end leaves that event out
+  CHECK(store.sorted_between(std::nextafter(2000.0, 2001.0), 2001) ==
+        Range(3, 6));
+  CHECK(store.sorted_between(1999, std::nextafter(2000.0, 1999.0)) ==
+        Range(0, 1));
+  CHECK(store.sorted_between(dates[4].Years(), 2002) == Range(4, 6));
+  // Nothing in view, before, between and after the events
+  CHECK(Empty(store.sorted_between(1000, 1998.5)));
+  CHECK(Empty(store.sorted_between(1999.1, 1999.9)));
+  CHECK(Empty(store.sorted_between(2001.5, 3000)));
+  CHECK(Empty(store.sorted_between(2001, 2000)));
+  // An unbounded view is everything
+  CHECK(store.sorted_between(-kInfinity, kInfinity) == Range(0, 6));
+
+  // Random views agree with a scan of every event
+  std::mt19937 random(23);
+  EventStore large;
+  for (uint64_t i = 0; i < 5000; ++i) {
+    large.emplace_back(i + 1,
+      *EventDate::Make(static_cast<int>(random() % 40) - 20, 1 + random() % 12,
+        random() % 29),
+      "", false, "");
+  }
+  (void)large.sort_by_date();
+  CHECK(large.sorted_by_date());
+  for (int view = 0; view < 1000; ++view) {
+    const double first = static_cast<double>(random() % 48000) / 1000 - 24;
+    const double last = first + static_cast<double>(random() % 3000) / 1000;
+    const auto range = large.sorted_between(first, last);
+    const auto scanned = Scan(large, first, last);
+    CHECK(range == scanned || (Empty(range) && Empty(scanned)));
+  }
+
+  return test::Result();
+}
@@ -0,0 +1,45 @@
+/*
+ * LineaOne - Specialized software for creating timelines for presentations.
+ * Copyright (C) 2024 kureii
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * File: test_check.h
+ * Created by kureii on 10/17/26
+ */
+#pragma once
+
+#include <iostream>
+#include <source_location>
+
+namespace linea_one::test {
+
+inline int failures = 0;
+
+inline void Check(bool const passed, const char* condition,
+  const std::source_location location = std::source_location::current()) {
+  if (!passed) {
+    std::cerr << location.file_name() << ":" << location.line()
+              << ": check failed: " << condition << std::endl;
+    ++failures;
+  }
+}
+
+/* Exit code of the test */
+inline int Result() { return failures == 0 ? 0 : 1; }
+
+}  // namespace linea_one::test
+
+#define CHECK(condition) \
+  linea_one::test::Check(static_cast<bool>(condition), #condition)